@@ -2,6 +2,9 @@
 #define CDS_ADVANCED_STRING_H
 
 #include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <stdint.h>
 #include <string.h>
 
 // An advanced string is, to put it simply, more than a character string
@@ -10,11 +13,10 @@
 //  - String literal concatenation
 //  - String literal assignment
 
-// Now, for formatting to be supported, its important to know that we
-// need extra size for the new formatted elements to be added correctly.
-// Here is the global variable holding that value:
+// Formatted strings used to be written in a buffer of strlen(format) + _STRING_APPEND characters
+// They are now measured while they are formatted, so this global is not used anymore
+// (it is kept so the code setting it still compiles)
 size_t _STRING_APPEND = 20;
-// Change it if you need more overhead, more space
 
 // You can overwrite this macro
 #ifndef STRING_REALLOC
@@ -28,38 +30,343 @@ size_t _STRING_APPEND = 20;
 #define STRING_FREE(ptr) free((ptr))
 #endif
 
+// Amount of characters a string that is full grows to
+// You can overwrite this macro with another (it must return more than c)
+#ifndef STRING_GROWTH
+#define STRING_GROWTH(c) ((c) < 16 ? 16 : (c)*2)
+#endif
+
 // Advanced string structure
+// The string holds capacity characters before it has to be reallocated (and always one more byte for '\0')
+// Appending only calls STRING_REALLOC when the capacity is exceeded, and the capacity then grows geometrically
+// (see STRING_GROWTH), so building a string from many small pieces only reallocates a few times
 struct String{
 	char* str;
 	size_t size;
+	size_t capacity;
 };
 
 // Create a new string
-// Here, the string starts with size=1
-// That is because the appending will fail to allocate the extra byte for '\0' otherwise
-#define create_string() (struct String){NULL,0};
+// Nothing is allocated until something is added to it
+#define create_string() (struct String){NULL,0,0}
+
+// Free / clear a string (a struct String or a struct SmallString)
+#define free_string(s) _Generic(&(s), struct String*: free_heap_string, struct SmallString*: free_small_string)(&(s))
+void free_heap_string(struct String* s){
+	if(s->str) STRING_FREE(s->str);
+	s->str = NULL;
+	s->size = s->capacity = 0;
+}
 
-// Free / clear a string
-#define free_string(s) ({if((s).size) STRING_FREE((s).str); (s).str = NULL; (s).size = 0;})
+// Get the characters of a string (a struct String or a struct SmallString), as a C string
+// An empty struct String with nothing allocated gives ""
+#define cstr_string(s) _Generic(&(s), struct String*: cstr_heap_string, struct SmallString*: cstr_small_string)(&(s))
+char* cstr_heap_string(struct String* s){
+	return s->str ? s->str : (char*)"";
+}
 
-// Set the string to another string that may be formatted
-#define set_string(d,s,...) ({\
-	(d).str = STRING_REALLOC(sizeof(char)*((d).size = strlen((s))+_STRING_APPEND+1));\
-	(d).size = sprintf((d).str,(s),##__VA_ARGS__);\
+// Get the size of a string (a struct String or a struct SmallString)
+#define length_string(s) _Generic(&(s), struct String*: length_heap_string, struct SmallString*: length_small_string)(&(s))
+size_t length_heap_string(struct String* s){
+	return s->size;
+}
+
+// Make sure string (d) can hold at least (n) characters (plus '\0'), without changing its size
+// Use it before building a string whose size you know, to allocate only once
+#define reserve_string(d,n) ({\
+	size_t s_n = (n);\
+	if(!(d).str || (d).capacity < s_n){\
+		(d).str = STRING_REALLOC((d).str,sizeof(char)*(s_n+1));\
+		if(!(d).capacity) (d).str[(d).size] = '\0';\
+		(d).capacity = s_n;\
+	}\
 })
 
-// Append a string to advanced string, may have a format
-#define append_string(d,s,...) ({\
-	(d).str = STRING_REALLOC((d).str,sizeof(char)*((d).size+strlen((s))+_STRING_APPEND+1));\
-	(d).size += sprintf((d).str+(d).size,(s),##__VA_ARGS__);\
-	(d).str[(d).size]='\0';\
+// Make sure string (d) can hold at least (n) characters, growing its capacity geometrically
+#define grow_string(d,n) ({\
+	size_t s_need = (n);\
+	if(!(d).str || (d).capacity < s_need){\
+		size_t s_cap = (d).str ? (d).capacity : 0;\
+		s_cap = STRING_GROWTH(s_cap);\
+		reserve_string((d),s_cap < s_need ? s_need : s_cap);\
+	}\
 })
 
-// Allocate (n) bytes for string
-#define alloc_string(d,n) ({\
-	(d).size += (n)+1;\
-	(d).str = STRING_REALLOC((d).str,sizeof(char)*(d).size);\
-	(d).str[(d).size]='\0';\
+// Append (n) bytes from (b) to string (d)
+// Only copies the bytes when the capacity allows it
+#define append_bytes_string(d,b,n) ({\
+	size_t s_len = (n);\
+	grow_string((d),(d).size+s_len);\
+	memcpy((d).str+(d).size,(b),s_len);\
+	(d).size += s_len;\
+	(d).str[(d).size] = '\0';\
 })
 
+// Append a single character (c) to string (d)
+#define append_char_string(d,c) ({\
+	grow_string((d),(d).size+1);\
+	(d).str[(d).size++] = (c);\
+	(d).str[(d).size] = '\0';\
+})
+
+// Append advanced string (s) to string (d) (they must not be the same string)
+#define concat_string(d,s) ({\
+	struct String s_from = (s);\
+	if(s_from.size) append_bytes_string((d),s_from.str,s_from.size);\
+})
+
+// Append a formatted string (printf format) to string (d)
+// The format attribute lets the compiler check the arguments against the format, like it does for printf
+// The string is formatted right into the space left in (d), and only when it doesn't fit,
+// (d) grows to its exact size and it is formatted again
+__attribute__((format(printf,2,0))) void vappend_format_string(struct String* d, const char* format, va_list args){
+	va_list retry;
+	grow_string((*d),d->size);
+	va_copy(retry,args);
+	size_t left = d->capacity-d->size;
+	int n = vsnprintf(d->str+d->size,left+1,format,args);
+	if(n > 0 && (size_t)n > left){
+		grow_string((*d),d->size+n);
+		vsnprintf(d->str+d->size,n+1,format,retry);
+	}
+	if(n > 0) d->size += n;
+	d->str[d->size] = '\0';
+	va_end(retry);
+}
+__attribute__((format(printf,2,3))) void append_format_string(struct String* d, const char* format, ...){
+	va_list args;
+	va_start(args,format);
+	vappend_format_string(d,format,args);
+	va_end(args);
+}
+
+// Set string (d) to a formatted string, its memory is kept
+__attribute__((format(printf,2,3))) void set_format_string(struct String* d, const char* format, ...){
+	va_list args;
+	va_start(args,format);
+	d->size = 0;
+	vappend_format_string(d,format,args);
+	va_end(args);
+}
+
+// Append a string to advanced string (a struct String or a struct SmallString), may have a format
+#define append_string(d,s,...) _Generic(&(d), struct String*: append_format_string, struct SmallString*: append_format_small_string)(&(d),(s),##__VA_ARGS__)
+
+// Set the string (a struct String or a struct SmallString) to another string that may be formatted
+// The memory of the string is kept, so setting it again and again doesn't reallocate
+#define set_string(d,s,...) _Generic(&(d), struct String*: set_format_string, struct SmallString*: set_format_small_string)(&(d),(s),##__VA_ARGS__)
+
+// Fast number appenders
+// They write numbers like printf does, without parsing a format
+
+// Pairs of digits, "00" to "99", to write numbers two digits at a time
+static const char string_digit_pairs[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+// Append unsigned integer (v) to string (d), like "%llu"
+void append_uint_string(struct String* d, unsigned long long v){
+	char buffer[20];
+	char* end = buffer+sizeof(buffer);
+	char* p = end;
+	while(v >= 100){
+		unsigned pair = (unsigned)(v % 100)*2;
+		v /= 100;
+		*--p = string_digit_pairs[pair+1];
+		*--p = string_digit_pairs[pair];
+	}
+	if(v >= 10){
+		*--p = string_digit_pairs[v*2+1];
+		*--p = string_digit_pairs[v*2];
+	}
+	else *--p = '0'+v;
+	append_bytes_string((*d),p,end-p);
+}
+
+// Append integer (v) to string (d), like "%lld"
+void append_int_string(struct String* d, long long v){
+	if(v < 0){
+		append_char_string((*d),'-');
+		append_uint_string(d,-(unsigned long long)v);
+	}
+	else append_uint_string(d,v);
+}
+
+// Append floating point number (v) to string (d) with (precision) digits after the point, like "%.*f"
+// Only up to 9 digits after the point are written (more are cut)
+// The number is multiplied by 10^precision and rounded to an integer, which can only be done exactly below 2^53:
+// bigger numbers (v*10^precision from 2^53), infinities and NaNs are written with snprintf
+// Below that, the digits are the same as printf's
+void append_float_string(struct String* d, double v, int precision){
+	static const double powers[] = {1,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9};
+	if(precision < 0) precision = 0;
+	if(precision > 9) precision = 9;
+	double magnitude = v < 0 ? -v : v;
+	if(!(magnitude*powers[precision] < 9007199254740992.0)){
+		append_format_string(d,"%.*f",precision,v);
+		return;
+	}
+	// magnitude*10^precision is rounded to a double, which can be on the wrong side of a halfway point,
+	// so the real product is computed as the sum of two doubles (exact+error)
+	// 10^precision is 5^precision (21 bits at most) times a power of 2, so magnitude is split in its upper 32 bits
+	// and the rest, and both of them times 10^precision fit in a double
+	uint64_t bits;
+	memcpy(&bits,&magnitude,sizeof(bits));
+	bits &= ~(uint64_t)0x1FFFFF;
+	double high;
+	memcpy(&high,&bits,sizeof(high));
+	double a = high*powers[precision], b = (magnitude-high)*powers[precision];
+	double exact = a+b, error = b-(exact-a);
+	// Round to the nearest, and to the even one when it is exactly halfway (like printf)
+	uint64_t scaled = (uint64_t)exact;
+	double rest = exact-(double)scaled;
+	if(rest == 0 && error < 0){ // The real product is just under an integer
+		scaled--;
+		rest = 1+error;
+	}
+	else if(rest == 0) rest = error;
+	else if(rest == 0.5 && error != 0) rest = error > 0 ? 1 : 0;
+	if(rest > 0.5 || (rest == 0.5 && (scaled & 1))) scaled++;
+	uint64_t whole = scaled/(uint64_t)powers[precision], fraction = scaled%(uint64_t)powers[precision];
+	if(signbit(v)) append_char_string((*d),'-');
+	append_uint_string(d,whole);
+	if(precision == 0) return;
+	char digits[10];
+	digits[0] = '.';
+	for(int i = precision; i > 0; i--){
+		digits[i] = '0'+fraction%10;
+		fraction /= 10;
+	}
+	append_bytes_string((*d),digits,precision+1);
+}
+
+// Allocate (n) more bytes for string, its size doesn't change
+#define alloc_string(d,n) reserve_string((d),(d).size+(n))
+
+// Small strings
+// Most strings are short (names, identifiers, keys...), but each struct String holding one is an allocation
+// A struct SmallString is a string that holds up to SMALL_STRING_SIZE-1 characters inside the structure itself,
+// and only moves them to the heap (as a struct String) when it gets longer, so short strings never allocate
+// The structure is 32 bytes: SMALL_STRING_SIZE bytes shared by the inline characters and the struct String,
+// and one byte with the size of the inline characters (or SMALL_STRING_HEAP once they moved to the heap)
+// A small string filled with zeros is an empty string
+//
+// create_small_string, set_string, append_string, free_string, cstr_string and length_string work with it
+// (the other macros of this header only work with struct String)
+/* EXAMPLE:
+
+struct SmallString name = create_small_string();
+set_string(name,"user_%d",42); // Inline, nothing is allocated
+append_string(name," with a name longer than 23 characters"); // Moved to the heap
+printf("%s\n",cstr_string(name));
+free_string(name);
+
+*/
+
+// Amount of bytes for the inline characters (with '\0'), they share them with a struct String
+#ifndef SMALL_STRING_SIZE
+#define SMALL_STRING_SIZE sizeof(struct String)
+#endif
+
+// Value of .small_size once the characters moved to the heap
+#define SMALL_STRING_HEAP 0xFF
+_Static_assert(SMALL_STRING_SIZE < SMALL_STRING_HEAP, "SMALL_STRING_SIZE must be less than 255");
+
+// Small string structure
+struct SmallString{
+	union{
+		char small[SMALL_STRING_SIZE]; // The characters, while they fit in it
+		struct String heap; // The characters, once they don't fit anymore
+	};
+	unsigned char small_size; // Amount of inline characters, or SMALL_STRING_HEAP
+};
+
+// Create a new small string, empty
+#define create_small_string() (struct SmallString){.small_size = 0}
+
+// Check if the characters of a small string are on the heap
+#define is_heap_small_string(s) ((s)->small_size == SMALL_STRING_HEAP)
+
+char* cstr_small_string(struct SmallString* s){
+	return is_heap_small_string(s) ? cstr_heap_string(&s->heap) : s->small;
+}
+
+size_t length_small_string(struct SmallString* s){
+	return is_heap_small_string(s) ? s->heap.size : s->small_size;
+}
+
+void free_small_string(struct SmallString* s){
+	if(is_heap_small_string(s)) free_heap_string(&s->heap);
+	s->small_size = 0;
+	s->small[0] = '\0';
+}
+
+// Move the inline characters of a small string to the heap, with room for at least n characters
+void spill_small_string(struct SmallString* s, size_t n){
+	struct String heap = create_string();
+	size_t capacity = STRING_GROWTH(SMALL_STRING_SIZE-1);
+	reserve_string(heap,n < capacity ? capacity : n);
+	memcpy(heap.str,s->small,s->small_size);
+	heap.size = s->small_size;
+	heap.str[heap.size] = '\0';
+	s->heap = heap;
+	s->small_size = SMALL_STRING_HEAP;
+}
+
+// Append (n) bytes from (b) to a small string (b must not be in that string)
+void append_bytes_small_string(struct SmallString* s, const void* b, size_t n){
+	if(!is_heap_small_string(s) && s->small_size+n >= SMALL_STRING_SIZE) spill_small_string(s,s->small_size+n);
+	if(is_heap_small_string(s)){
+		append_bytes_string(s->heap,b,n);
+		return;
+	}
+	memcpy(s->small+s->small_size,b,n);
+	s->small_size += n;
+	s->small[s->small_size] = '\0';
+}
+
+// Append a formatted string to a small string, formatted right into its inline characters when it fits
+__attribute__((format(printf,2,0))) void vappend_format_small_string(struct SmallString* s, const char* format, va_list args){
+	if(is_heap_small_string(s)){
+		vappend_format_string(&s->heap,format,args);
+		return;
+	}
+	va_list retry;
+	va_copy(retry,args);
+	size_t left = SMALL_STRING_SIZE-1-s->small_size;
+	int n = vsnprintf(s->small+s->small_size,left+1,format,args);
+	if(n > 0 && (size_t)n <= left) s->small_size += n;
+	else if(n > 0){
+		spill_small_string(s,s->small_size+n);
+		vsnprintf(s->heap.str+s->heap.size,n+1,format,retry);
+		s->heap.size += n;
+	}
+	if(!is_heap_small_string(s)) s->small[s->small_size] = '\0';
+	va_end(retry);
+}
+__attribute__((format(printf,2,3))) void append_format_small_string(struct SmallString* s, const char* format, ...){
+	va_list args;
+	va_start(args,format);
+	vappend_format_small_string(s,format,args);
+	va_end(args);
+}
+
+// Set a small string to a formatted string, its memory is kept (once on the heap, it stays there)
+__attribute__((format(printf,2,3))) void set_format_small_string(struct SmallString* s, const char* format, ...){
+	va_list args;
+	va_start(args,format);
+	if(is_heap_small_string(s)) s->heap.size = 0;
+	else s->small_size = 0;
+	vappend_format_small_string(s,format,args);
+	va_end(args);
+}
+
 #endif
@@ -0,0 +1,261 @@
+#ifndef CDS_ALLOCATOR_H
+#define CDS_ALLOCATOR_H
+
+#include <stdlib.h>
+#include <string.h>
+
+// Allocators that can replace realloc and free in the other headers of this library
+// (VECTOR_REALLOC / VECTOR_FREE, HASHTABLE_REALLOC / HASHTABLE_FREE, STRING_REALLOC / STRING_FREE)
+//
+// - An arena (arena_t) gives memory from big chunks, one block after the other (a bump pointer)
+//   Allocating is just moving that pointer, and a block can only be given back if it is the last one
+//   Growing the last block is done in place, which is what a growing vector or string does most of the time
+// - A pool (pool_t) is an arena where freed blocks are kept by size (16, 32, 64... bytes) to be reused
+//   So things that are allocated and freed all the time (like the hashsets of a hashtable) don't waste memory
+//
+// Resetting an arena or a pool frees everything allocated from it at once, in O(1): its chunks are kept and reused
+// Which means a whole hashtable, or a batch of strings, can be freed without walking through them
+//
+// To use them, include this header first, then define the hooks of the other headers as the ones below:
+/* EXAMPLE:
+
+#include "allocator.h"
+#define VECTOR_REALLOC ARENA_REALLOC
+#define VECTOR_FREE ARENA_FREE
+#include "hashtable.h"
+
+arena_t arena = create_arena(1 << 20); // Chunks of 1 MiB
+current_arena = &arena;
+hashtable_t ht = create_ht(hash_u64_key_ht,16,sizeof(pair_t));
+setup_ht(&ht,1024);
+--- Add pairs, find pairs... ---
+reset_arena(&arena); // ht is freed, don't call free_ht on it
+ht = create_ht(hash_u64_key_ht,16,sizeof(pair_t));
+--- Use it again, in the same memory ---
+free_arena(&arena);
+
+*/
+// The hooks use current_arena and current_pool, so every vector, hashtable or string of the file
+// must be allocated (and freed) while the same arena or pool is current
+// Define ALLOCATOR_THREAD_LOCAL before including this header to have one current arena and pool per thread
+
+// Alignment of every block (enough for any standard type)
+#ifndef ALLOCATOR_ALIGN
+#define ALLOCATOR_ALIGN 16
+#endif
+
+// Round x up to a multiple of ALLOCATOR_ALIGN
+#define align_allocator(x) (((x)+ALLOCATOR_ALIGN-1) & ~(size_t)(ALLOCATOR_ALIGN-1))
+
+// A chunk of an arena, the blocks are right after it
+typedef struct arena_chunk_t{
+	struct arena_chunk_t* next;
+	size_t capacity; // Bytes available for the blocks
+} arena_chunk_t;
+
+// Get the start of the blocks of a chunk
+#define arena_chunk_data(c) ((char*)(c)+align_allocator(sizeof(arena_chunk_t)))
+
+// Each block is preceded by ALLOCATOR_ALIGN bytes holding its size (rounded up to ALLOCATOR_ALIGN)
+#define arena_block_size(p) (*(size_t*)((char*)(p)-ALLOCATOR_ALIGN))
+
+// The arena structure
+typedef struct {
+	arena_chunk_t* first; // First chunk (NULL when nothing was allocated yet)
+	arena_chunk_t* current; // Chunk the blocks are taken from
+	size_t used; // Bytes used in the current chunk
+	void* last; // Last block allocated, the only one that can grow in place or be given back (NULL if there is none)
+	size_t chunk_size; // Size of a new chunk, in bytes (bigger blocks get a chunk of their size)
+} arena_t;
+
+// Create an arena with nothing in it, that allocates chunks of chunk_size bytes
+#define create_arena(chunk_size) (arena_t){NULL,NULL,0,NULL,(chunk_size)}
+
+// Move to the next chunk of the arena, that has at least need bytes (allocate it if there is none)
+void next_chunk_arena(arena_t* a, size_t need){
+	arena_chunk_t* next = a->current ? a->current->next : a->first;
+	if(next == NULL || next->capacity < need){
+		size_t capacity = need > a->chunk_size ? need : a->chunk_size;
+		arena_chunk_t* chunk = malloc(align_allocator(sizeof(arena_chunk_t))+capacity);
+		if(chunk == NULL) return;
+		chunk->capacity = capacity;
+		chunk->next = next;
+		if(a->current) a->current->next = chunk;
+		else a->first = chunk;
+		next = chunk;
+	}
+	a->current = next;
+	a->used = 0;
+	a->last = NULL;
+}
+
+// Allocate a block of size bytes from the arena
+// Returns NULL if there is no memory left
+void* alloc_arena(arena_t* a, size_t size){
+	size_t need = ALLOCATOR_ALIGN+align_allocator(size);
+	if(a->current == NULL || a->used+need > a->current->capacity){
+		next_chunk_arena(a,need);
+		if(a->current == NULL || a->used+need > a->current->capacity) return NULL;
+	}
+	char* block = arena_chunk_data(a->current)+a->used;
+	*(size_t*)block = align_allocator(size);
+	a->used += need;
+	a->last = block+ALLOCATOR_ALIGN;
+	return a->last;
+}
+
+// Give a block back to the arena
+// Only the last block allocated is really given back, the others stay until the arena is reset
+void dealloc_arena(arena_t* a, void* ptr){
+	if(ptr == NULL || ptr != a->last) return;
+	a->used = (char*)ptr-ALLOCATOR_ALIGN-arena_chunk_data(a->current);
+	a->last = NULL;
+}
+
+// Change the size of a block of the arena, like realloc
+// 1. If the block is big enough already, it is kept as it is
+// 2. If it is the last block and there is room after it in its chunk, it grows in place
+// 3. Else, a new block is allocated and the old one is copied in it
+void* realloc_arena(arena_t* a, void* ptr, size_t size){
+	if(ptr == NULL) return alloc_arena(a,size);
+	if(size == 0){
+		dealloc_arena(a,ptr);
+		return NULL;
+	}
+	size_t old_size = arena_block_size(ptr), new_size = align_allocator(size);
+	// Step 1 (the last block shrinks, so the end of it can be used again)
+	if(new_size <= old_size && ptr != a->last) return ptr;
+	// Step 2
+	if(ptr == a->last){
+		size_t start = (char*)ptr-arena_chunk_data(a->current);
+		if(start+new_size <= a->current->capacity){
+			arena_block_size(ptr) = new_size;
+			a->used = start+new_size;
+			return ptr;
+		}
+	}
+	// Step 3
+	void* new_ptr = alloc_arena(a,size);
+	if(new_ptr) memcpy(new_ptr,ptr,old_size);
+	return new_ptr;
+}
+
+// Free everything allocated from the arena at once, in O(1)
+// Its chunks are kept, to be used again by the next allocations
+void reset_arena(arena_t* a){
+	a->current = a->first;
+	a->used = 0;
+	a->last = NULL;
+}
+
+// Free the arena and all its chunks
+void free_arena(arena_t* a){
+	while(a->first){
+		arena_chunk_t* next = a->first->next;
+		free(a->first);
+		a->first = next;
+	}
+	*a = create_arena(a->chunk_size);
+}
+
+// Smallest block of a pool, in bytes (a power of two, at least ALLOCATOR_ALIGN)
+#ifndef POOL_MIN_BLOCK
+#define POOL_MIN_BLOCK 16
+#endif
+
+// Amount of block sizes of a pool: POOL_MIN_BLOCK, 2*POOL_MIN_BLOCK... up to POOL_MIN_BLOCK << (POOL_CLASSES-1)
+// Bigger blocks are taken from the arena of the pool directly, and only freed when the pool is reset
+#ifndef POOL_CLASSES
+#define POOL_CLASSES 12
+#endif
+
+// The pool structure
+typedef struct {
+	arena_t arena; // Where the blocks come from
+	void* free_blocks[POOL_CLASSES]; // Freed blocks of each size, each one pointing to the next
+} pool_t;
+
+// Create a pool with nothing in it, that allocates chunks of chunk_size bytes
+#define create_pool(chunk_size) (pool_t){create_arena((chunk_size))}
+
+// Get the class of a block of size bytes (POOL_CLASSES if it is too big for a class)
+unsigned int class_pool(size_t size){
+	unsigned int c = 0;
+	while(c < POOL_CLASSES && ((size_t)POOL_MIN_BLOCK << c) < size) c++;
+	return c;
+}
+
+// Allocate a block of size bytes from the pool
+// A freed block of the same class is used if there is one
+void* alloc_pool(pool_t* p, size_t size){
+	unsigned int c = class_pool(size);
+	if(c == POOL_CLASSES) return alloc_arena(&p->arena,size);
+	void* block = p->free_blocks[c];
+	if(block){
+		p->free_blocks[c] = *(void**)block;
+		return block;
+	}
+	return alloc_arena(&p->arena,(size_t)POOL_MIN_BLOCK << c);
+}
+
+// Give a block back to the pool, so it can be used again
+void dealloc_pool(pool_t* p, void* ptr){
+	if(ptr == NULL) return;
+	unsigned int c = class_pool(arena_block_size(ptr));
+	if(c == POOL_CLASSES){
+		dealloc_arena(&p->arena,ptr);
+		return;
+	}
+	*(void**)ptr = p->free_blocks[c];
+	p->free_blocks[c] = ptr;
+}
+
+// Change the size of a block of the pool, like realloc
+// The block is kept if it is big enough, else it moves to a block of a bigger class
+// (blocks too big for a class grow in place when they are the last block of the arena)
+void* realloc_pool(pool_t* p, void* ptr, size_t size){
+	if(ptr == NULL) return alloc_pool(p,size);
+	if(size == 0){
+		dealloc_pool(p,ptr);
+		return NULL;
+	}
+	size_t old_size = arena_block_size(ptr);
+	if(size <= old_size) return ptr;
+	if(class_pool(old_size) == POOL_CLASSES) return realloc_arena(&p->arena,ptr,size);
+	void* new_ptr = alloc_pool(p,size);
+	if(new_ptr){
+		memcpy(new_ptr,ptr,old_size);
+		dealloc_pool(p,ptr);
+	}
+	return new_ptr;
+}
+
+// Free everything allocated from the pool at once, in O(1)
+void reset_pool(pool_t* p){
+	reset_arena(&p->arena);
+	memset(p->free_blocks,0,sizeof(p->free_blocks));
+}
+
+// Free the pool and all its chunks
+void free_pool(pool_t* p){
+	free_arena(&p->arena);
+	memset(p->free_blocks,0,sizeof(p->free_blocks));
+}
+
+#ifdef ALLOCATOR_THREAD_LOCAL
+#define ALLOCATOR_STORAGE _Thread_local
+#else
+#define ALLOCATOR_STORAGE
+#endif
+
+// The arena and the pool used by the hooks below
+ALLOCATOR_STORAGE arena_t* current_arena = NULL;
+ALLOCATOR_STORAGE pool_t* current_pool = NULL;
+
+// Hooks to define VECTOR_REALLOC, HASHTABLE_REALLOC, STRING_REALLOC... as
+#define ARENA_REALLOC(ptr, sz) realloc_arena(current_arena,(ptr),(sz))
+#define ARENA_FREE(ptr) dealloc_arena(current_arena,(ptr))
+#define POOL_REALLOC(ptr, sz) realloc_pool(current_pool,(ptr),(sz))
+#define POOL_FREE(ptr) dealloc_pool(current_pool,(ptr))
+
+#endif
@@ -0,0 +1,299 @@
+#ifndef CDS_ATOMIC_QUEUE_H
+#define CDS_ATOMIC_QUEUE_H
+
+// IMPORTANT! THIS HEADER NEEDS C11 ATOMICS (<stdatomic.h>)!
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Queues that can be shared by threads without any lock:
+// - mpsc_queue_t : Any amount of producers, one consumer, unbounded and intrusive (it links the nodes you give it)
+// - mpmc_queue_t : Any amount of producers and consumers, bounded (a ring of pointers)
+// - spsc_ring_t : One producer, one consumer, bounded (a ring of elements, copied in and out)
+// Pushing and popping never wait for another thread: when a bounded queue is full or a queue is empty, they fail right away
+// (so a thread that must wait has to try again, and yield or sleep between tries if it could wait long)
+
+// Size of a cache line, the members written by producers and by consumers are kept on different ones
+#ifndef ATOMIC_QUEUE_CACHE_LINE
+#define ATOMIC_QUEUE_CACHE_LINE 64
+#endif
+
+// You can overwrite these macros, to allocate the rings
+#ifndef ATOMIC_QUEUE_ALLOC
+#include <stdlib.h>
+#define ATOMIC_QUEUE_ALLOC(sz) malloc((sz))
+#endif
+
+#ifndef ATOMIC_QUEUE_FREE
+#include <stdlib.h>
+#define ATOMIC_QUEUE_FREE(ptr) free((ptr))
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+// MPSC queue
+// An intrusive queue of singly linked list nodes (see singly_linked_list_with in linked_list.h)
+// Their ->next pointer (the first member) is used to link them, so pushing never allocates anything
+// A node can only be in one queue at a time, and must stay allocated until it is popped
+//
+// Producers swap the head of the queue with their node in one atomic exchange, then link the previous head to it
+// The consumer follows the links from the tail, so it only sees nodes that are fully linked
+// The ->next pointers are accessed as _Atomic(void*), which has the same size and layout as void* with GCC and Clang
+/* EXAMPLE:
+
+typedef singly_linked_list_with(int id) job_t;
+
+mpsc_queue_t jobs;
+create_mpsc_queue(&jobs);
+--- In any producer thread ---
+job_t* job = malloc(sizeof(job_t));
+*job = (job_t) create_singly_list_node(42);
+push_mpsc_queue(&jobs,job);
+--- In the consumer thread ---
+job_t* next_job = pop_mpsc_queue(&jobs); // NULL if there are no jobs (yet)
+
+*/
+
+// A node of a MPSC queue, any singly linked list node starts like this
+typedef struct {
+	_Atomic(void*) next;
+} mpsc_node_t;
+
+// The MPSC queue structure
+// It must not be moved or copied once created (the stub node is inside it)
+typedef struct {
+	_Atomic(void*) head; // Last node pushed (written by the producers)
+	char padding[ATOMIC_QUEUE_CACHE_LINE];
+	mpsc_node_t* tail; // Next node to pop (only used by the consumer)
+	mpsc_node_t stub; // Node kept in the queue when it would be empty, so producers never see a NULL head
+} mpsc_queue_t;
+
+// Create an empty MPSC queue
+void create_mpsc_queue(mpsc_queue_t* q){
+	atomic_init(&q->stub.next,NULL);
+	atomic_init(&q->head,&q->stub);
+	q->tail = &q->stub;
+}
+
+// Push node n at the end of the queue, from any thread
+void push_mpsc_queue(mpsc_queue_t* q, void* n){
+	mpsc_node_t* node = n;
+	atomic_store_explicit(&node->next,NULL,memory_order_relaxed);
+	mpsc_node_t* previous = atomic_exchange_explicit(&q->head,node,memory_order_acq_rel);
+	// Between the exchange and this store, the consumer can't go past previous (the queue looks shorter than it is)
+	atomic_store_explicit(&previous->next,node,memory_order_release);
+}
+
+// Pop the first node of the queue, from the consumer thread only
+// Returns NULL if the queue is empty, or if the first node is still being linked by its producer
+void* pop_mpsc_queue(mpsc_queue_t* q){
+	mpsc_node_t* tail = q->tail;
+	mpsc_node_t* next = atomic_load_explicit(&tail->next,memory_order_acquire);
+	// Skip the stub node
+	if(tail == &q->stub){
+		if(next == NULL) return NULL;
+		q->tail = tail = next;
+		next = atomic_load_explicit(&next->next,memory_order_acquire);
+	}
+	if(next){
+		q->tail = next;
+		return tail;
+	}
+	// tail is the last node linked, it can only be popped if no producer is pushing after it
+	if(tail != atomic_load_explicit(&q->head,memory_order_acquire)) return NULL;
+	// Push the stub again, so the queue is never left without a node
+	push_mpsc_queue(q,&q->stub);
+	next = atomic_load_explicit(&tail->next,memory_order_acquire);
+	if(next){
+		q->tail = next;
+		return tail;
+	}
+	return NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// MPMC queue
+// A bounded queue of pointers (to nodes, or anything else), that any amount of threads can push to and pop from
+// An intrusive linked list (like the Michael-Scott queue) would need every popped node to stay allocated
+// as long as another thread might still read it, so this is a ring of cells instead:
+// each cell has a sequence number telling whether it is ready to be written (by the push with the same position)
+// or read (by the pop with the same position), and threads claim positions with a compare and swap
+/* EXAMPLE:
+
+mpmc_queue_t jobs;
+create_mpmc_queue(&jobs,1024);
+--- In any producer thread ---
+while(!push_mpmc_queue(&jobs,job)) sched_yield(); // Full, try again
+--- In any consumer thread ---
+job_t* next_job = pop_mpmc_queue(&jobs); // NULL if there are no jobs
+--- When no thread uses it anymore ---
+free_mpmc_queue(&jobs);
+
+*/
+
+// A cell of a MPMC queue
+typedef struct {
+	atomic_size_t sequence;
+	void* data;
+} mpmc_cell_t;
+
+// The MPMC queue structure
+typedef struct {
+	mpmc_cell_t* cells;
+	size_t mask; // Amount of cells - 1 (the amount of cells is a power of two)
+	char padding1[ATOMIC_QUEUE_CACHE_LINE];
+	atomic_size_t push_pos; // Position of the next push
+	char padding2[ATOMIC_QUEUE_CACHE_LINE];
+	atomic_size_t pop_pos; // Position of the next pop
+	char padding3[ATOMIC_QUEUE_CACHE_LINE];
+} mpmc_queue_t;
+
+// Create an empty MPMC queue that can hold capacity pointers (rounded up to a power of two)
+// Returns 0, or -1 if the cells could not be allocated
+int create_mpmc_queue(mpmc_queue_t* q, size_t capacity){
+	size_t size = 2;
+	while(size < capacity) size *= 2;
+	q->cells = ATOMIC_QUEUE_ALLOC(sizeof(mpmc_cell_t)*size);
+	if(q->cells == NULL) return -1;
+	q->mask = size-1;
+	for(size_t i = 0; i < size; i++) atomic_init(&q->cells[i].sequence,i);
+	atomic_init(&q->push_pos,0);
+	atomic_init(&q->pop_pos,0);
+	return 0;
+}
+
+// Free a MPMC queue (not the pointers that are still in it)
+void free_mpmc_queue(mpmc_queue_t* q){
+	if(q->cells) ATOMIC_QUEUE_FREE(q->cells);
+	q->cells = NULL;
+}
+
+// Push a pointer at the end of the queue, from any thread
+// Returns 0 if the queue is full (nothing is pushed), 1 otherwise
+_Bool push_mpmc_queue(mpmc_queue_t* q, void* data){
+	size_t pos = atomic_load_explicit(&q->push_pos,memory_order_relaxed);
+	for(;;){
+		mpmc_cell_t* cell = &q->cells[pos & q->mask];
+		size_t sequence = atomic_load_explicit(&cell->sequence,memory_order_acquire);
+		intptr_t diff = (intptr_t)sequence-(intptr_t)pos;
+		if(diff == 0){
+			// The cell is free, claim the position (pos is updated if another thread claimed it first)
+			if(atomic_compare_exchange_weak_explicit(&q->push_pos,&pos,pos+1,memory_order_relaxed,memory_order_relaxed)){
+				cell->data = data;
+				atomic_store_explicit(&cell->sequence,pos+1,memory_order_release);
+				return 1;
+			}
+		}
+		else if(diff < 0) return 0; // The cell was not popped yet, the queue is full
+		else pos = atomic_load_explicit(&q->push_pos,memory_order_relaxed);
+	}
+}
+
+// Pop the first pointer of the queue, from any thread
+// Returns NULL if the queue is empty (so don't push NULL pointers)
+void* pop_mpmc_queue(mpmc_queue_t* q){
+	size_t pos = atomic_load_explicit(&q->pop_pos,memory_order_relaxed);
+	for(;;){
+		mpmc_cell_t* cell = &q->cells[pos & q->mask];
+		size_t sequence = atomic_load_explicit(&cell->sequence,memory_order_acquire);
+		intptr_t diff = (intptr_t)sequence-(intptr_t)(pos+1);
+		if(diff == 0){
+			if(atomic_compare_exchange_weak_explicit(&q->pop_pos,&pos,pos+1,memory_order_relaxed,memory_order_relaxed)){
+				void* data = cell->data;
+				// The cell is free again for the push one lap later
+				atomic_store_explicit(&cell->sequence,pos+q->mask+1,memory_order_release);
+				return data;
+			}
+		}
+		else if(diff < 0) return NULL; // The cell was not pushed yet, the queue is empty
+		else pos = atomic_load_explicit(&q->pop_pos,memory_order_relaxed);
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// SPSC ring
+// A bounded queue of elements of element_size bytes, for exactly one producer thread and one consumer thread
+// The elements are copied in the ring, so nothing needs to stay allocated
+// Each side keeps a copy of the position of the other side, and only reads the real one (from the cache of the other core)
+// when that copy says the ring is full or empty
+/* EXAMPLE:
+
+spsc_ring_t samples;
+create_spsc_ring(&samples,4096,sizeof(float));
+--- In the producer thread ---
+float sample = 0.5f;
+if(!push_spsc_ring(&samples,&sample)) printf("Ring full, dropped a sample!\n");
+--- In the consumer thread ---
+float sample;
+while(pop_spsc_ring(&samples,&sample)) process(sample);
+--- When no thread uses it anymore ---
+free_spsc_ring(&samples);
+
+*/
+
+// The SPSC ring structure
+typedef struct {
+	char* elements;
+	size_t mask; // Amount of elements - 1 (the amount of elements is a power of two)
+	size_t element_size; // Size of an element, in bytes
+	char padding1[ATOMIC_QUEUE_CACHE_LINE];
+	atomic_size_t push_pos; // Position of the next push (written by the producer)
+	size_t cached_pop_pos; // Copy of pop_pos, only used by the producer
+	char padding2[ATOMIC_QUEUE_CACHE_LINE];
+	atomic_size_t pop_pos; // Position of the next pop (written by the consumer)
+	size_t cached_push_pos; // Copy of push_pos, only used by the consumer
+	char padding3[ATOMIC_QUEUE_CACHE_LINE];
+} spsc_ring_t;
+
+// Create an empty SPSC ring that can hold capacity elements (rounded up to a power of two) of element_size bytes
+// Returns 0, or -1 if the elements could not be allocated
+int create_spsc_ring(spsc_ring_t* r, size_t capacity, size_t element_size){
+	size_t size = 1;
+	while(size < capacity) size *= 2;
+	r->elements = ATOMIC_QUEUE_ALLOC(element_size*size);
+	if(r->elements == NULL) return -1;
+	r->mask = size-1;
+	r->element_size = element_size;
+	atomic_init(&r->push_pos,0);
+	atomic_init(&r->pop_pos,0);
+	r->cached_pop_pos = r->cached_push_pos = 0;
+	return 0;
+}
+
+// Free a SPSC ring
+void free_spsc_ring(spsc_ring_t* r){
+	if(r->elements) ATOMIC_QUEUE_FREE(r->elements);
+	r->elements = NULL;
+}
+
+// Copy the element at the end of the ring, from the producer thread only
+// Returns 0 if the ring is full (nothing is pushed), 1 otherwise
+_Bool push_spsc_ring(spsc_ring_t* r, const void* element){
+	size_t pos = atomic_load_explicit(&r->push_pos,memory_order_relaxed);
+	if(pos-r->cached_pop_pos > r->mask){
+		r->cached_pop_pos = atomic_load_explicit(&r->pop_pos,memory_order_acquire);
+		if(pos-r->cached_pop_pos > r->mask) return 0;
+	}
+	memcpy(r->elements+(pos & r->mask)*r->element_size,element,r->element_size);
+	atomic_store_explicit(&r->push_pos,pos+1,memory_order_release);
+	return 1;
+}
+
+// Copy the first element of the ring to element, and remove it, from the consumer thread only
+// Returns 0 if the ring is empty (element is left as it is), 1 otherwise
+_Bool pop_spsc_ring(spsc_ring_t* r, void* element){
+	size_t pos = atomic_load_explicit(&r->pop_pos,memory_order_relaxed);
+	if(pos == r->cached_push_pos){
+		r->cached_push_pos = atomic_load_explicit(&r->push_pos,memory_order_acquire);
+		if(pos == r->cached_push_pos) return 0;
+	}
+	memcpy(element,r->elements+(pos & r->mask)*r->element_size,r->element_size);
+	atomic_store_explicit(&r->pop_pos,pos+1,memory_order_release);
+	return 1;
+}
+
+// Amount of elements in the ring (already out of date if the other thread is using it)
+#define size_spsc_ring(r) (atomic_load(&(r).push_pos)-atomic_load(&(r).pop_pos))
+
+#endif
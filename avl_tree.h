@@ -0,0 +1,248 @@
+#ifndef CDS_AVL_TREE_H
+#define CDS_AVL_TREE_H
+
+// IMPORTANT! THIS HEADER DEPENDS ON "binary_tree.h"!
+
+// We need the binary tree nodes
+#include "binary_tree.h"
+
+// An AVL tree is a sorted binary tree that stays balanced:
+// for every node, the heights of its left and right subtrees differ by 1 at most
+// After each insertion or removal, the nodes on the path to the root are rotated when that is not true anymore
+// So its height stays under 1.44 * log2(n), even when the nodes are added in order (which makes add_binary_tree_node
+// build a linked list), and adding, finding and removing a node are always O(log n)
+//
+// An AVL tree node structure is a binary tree node (see binary_tree.h) with two more members:
+// 	* .parent : Pointer to the parent node (NULL for the root)
+// 	* .height : Height of the subtree starting at this node (1 for a node without children)
+// 	!! These members should always be right after .left and .right
+// So the functions of binary_tree.h (like free_binary_tree or print_binary_tree) also work with AVL trees
+// Nodes are allocated by you, and removed nodes are given to BINARY_TREE_FREE_NODE
+/* EXAMPLE OF AVL TREE NODE STRUCTURE
+struct int_avl_tree {
+	void *left, *right, *parent;
+	int height;
+	int value;
+};
+OR
+avl_tree_with(int value) int_avl_tree;
+*/
+// The nodes are sorted with a comparison function, like add_binary_tree_node:
+// it takes a node already in the tree (p) and another node (n), and returns true if n goes after p (to its right)
+// Two nodes are equal when neither goes after the other
+/* EXAMPLE:
+
+typedef avl_tree_with(long timestamp) event_t;
+
+_Bool event_after(void* p, void* n){
+	return ((event_t*)n)->timestamp > ((event_t*)p)->timestamp;
+}
+
+event_t* root = NULL;
+for(long t = 0; t < 1000000; t++){
+	event_t* event = malloc(sizeof(event_t));
+	*event = (event_t) create_avl_tree_node(t);
+	add_avl_tree_node(&root,event,event_after);
+}
+event_t key = (event_t) create_avl_tree_node(500000);
+event_t* found = find_avl_tree_node(root,&key,event_after);
+
+*/
+
+// Template to create an AVL tree node type easily
+// Example: typedef avl_tree_with(int number) number_avl_tree_t;
+#define avl_tree_with(data) struct { void *left, *right, *parent; int height; data; }
+
+// Create a new AVL tree node
+// You can use extra arguments to set other members of the new node
+#define create_avl_tree_node(...) {NULL,NULL,NULL,1,##__VA_ARGS__}
+
+// Template type to represent an AVL tree node with no data involved
+struct avl_template_t{
+	struct avl_template_t* left;
+	struct avl_template_t* right;
+	struct avl_template_t* parent;
+	int height;
+};
+
+// Height of a subtree (0 for an empty one)
+#define avl_tree_height(n) ((n) ? ((struct avl_template_t*)(n))->height : 0)
+
+// Recompute the height of node n from its children
+void update_avl_tree_height(struct avl_template_t* n){
+	int left = avl_tree_height(n->left), right = avl_tree_height(n->right);
+	n->height = (left > right ? left : right)+1;
+}
+
+// Make child replace old_child as a child of parent (or as the root if parent is NULL)
+void replace_avl_tree_child(void** root, struct avl_template_t* parent, struct avl_template_t* old_child, struct avl_template_t* child){
+	if(parent == NULL) *root = child;
+	else if(parent->left == old_child) parent->left = child;
+	else parent->right = child;
+	if(child) child->parent = parent;
+}
+
+// Rotate node n to the left (its right child takes its place), and return its right child
+// n becomes the left child of its right child r, and the left child of r becomes the right child of n
+struct avl_template_t* rotate_left_avl_tree(void** root, struct avl_template_t* n){
+	struct avl_template_t* r = n->right;
+	n->right = r->left;
+	if(r->left) r->left->parent = n;
+	replace_avl_tree_child(root,n->parent,n,r);
+	r->left = n;
+	n->parent = r;
+	update_avl_tree_height(n);
+	update_avl_tree_height(r);
+	return r;
+}
+
+// Rotate node n to the right (its left child takes its place), and return its left child
+// n becomes the right child of its left child l, and the right child of l becomes the left child of n
+struct avl_template_t* rotate_right_avl_tree(void** root, struct avl_template_t* n){
+	struct avl_template_t* l = n->left;
+	n->left = l->right;
+	if(l->right) l->right->parent = n;
+	replace_avl_tree_child(root,n->parent,n,l);
+	l->right = n;
+	n->parent = l;
+	update_avl_tree_height(n);
+	update_avl_tree_height(l);
+	return l;
+}
+
+// Update the heights from node n up to the root, rotating the nodes that are not balanced anymore
+void rebalance_avl_tree(void** root, struct avl_template_t* n){
+	while(n){
+		update_avl_tree_height(n);
+		int balance = avl_tree_height(n->left)-avl_tree_height(n->right);
+		if(balance > 1){
+			if(avl_tree_height(n->left->left) < avl_tree_height(n->left->right)) rotate_left_avl_tree(root,n->left);
+			n = rotate_right_avl_tree(root,n);
+		}
+		else if(balance < -1){
+			if(avl_tree_height(n->right->right) < avl_tree_height(n->right->left)) rotate_right_avl_tree(root,n->right);
+			n = rotate_left_avl_tree(root,n);
+		}
+		n = n->parent;
+	}
+}
+
+// Add a node to an AVL tree, and rebalance it
+// root is a pointer to the variable holding the root node (it changes when the tree is rotated)
+// The node goes after the nodes it is equal to, so they stay in the order they were added
+void add_avl_tree_node(void* root, void* node_ptr, _Bool (*comparison_func)(void*,void*)){
+	if(node_ptr == NULL) return;
+	void** root_ptr = root;
+	struct avl_template_t *node = node_ptr, *parent = NULL, *current = *root_ptr;
+	_Bool right = 0;
+	while(current){
+		parent = current;
+		right = !comparison_func(node,current); // Not before current
+		current = right ? current->right : current->left;
+	}
+	node->left = node->right = NULL;
+	node->parent = parent;
+	node->height = 1;
+	if(parent == NULL) *root_ptr = node;
+	else if(right) parent->right = node;
+	else parent->left = node;
+	rebalance_avl_tree(root_ptr,parent);
+}
+
+// Find a node equal to key in an AVL tree (NULL if there is none)
+// key is a node with the members used by the comparison function set
+void* find_avl_tree_node(void* root, void* key, _Bool (*comparison_func)(void*,void*)){
+	struct avl_template_t* current = root;
+	while(current){
+		if(comparison_func(current,key)) current = current->right;
+		else if(comparison_func(key,current)) current = current->left;
+		else return current;
+	}
+	return NULL;
+}
+
+// Find the first node that is not before key in an AVL tree (NULL if all the nodes are before it)
+void* lower_bound_avl_tree_node(void* root, void* key, _Bool (*comparison_func)(void*,void*)){
+	struct avl_template_t *current = root, *result = NULL;
+	while(current){
+		if(comparison_func(current,key)) current = current->right;
+		else{
+			result = current;
+			current = current->left;
+		}
+	}
+	return result;
+}
+
+// Get the first (smallest) / last (biggest) node of a tree or subtree (NULL if it is empty)
+void* min_avl_tree_node(void* root){
+	struct avl_template_t* current = root;
+	while(current && current->left) current = current->left;
+	return current;
+}
+void* max_avl_tree_node(void* root){
+	struct avl_template_t* current = root;
+	while(current && current->right) current = current->right;
+	return current;
+}
+
+// Get the node after / before node n in the tree (NULL if it is the last / first one)
+void* next_avl_tree_node(void* n){
+	struct avl_template_t* node = n;
+	if(node->right) return min_avl_tree_node(node->right);
+	while(node->parent && node == node->parent->right) node = node->parent;
+	return node->parent;
+}
+void* previous_avl_tree_node(void* n){
+	struct avl_template_t* node = n;
+	if(node->left) return max_avl_tree_node(node->left);
+	while(node->parent && node == node->parent->left) node = node->parent;
+	return node->parent;
+}
+
+// Remove node n from an AVL tree, rebalance it, then call BINARY_TREE_FREE_NODE on n
+// root is a pointer to the variable holding the root node, n must be in that tree
+// 1. If n has less than 2 children, its child (or nothing) takes its place
+// 2. Else, the node right after it (the smallest of its right subtree) takes its place
+// Nodes are moved, not copied, so the pointers to the other nodes stay valid
+void erase_avl_tree_node(void* root, void* n){
+	if(n == NULL) return;
+	void** root_ptr = root;
+	struct avl_template_t *node = n, *rebalance_from;
+	// Step 1
+	if(node->left == NULL || node->right == NULL){
+		rebalance_from = node->parent;
+		replace_avl_tree_child(root_ptr,node->parent,node,node->left ? node->left : node->right);
+	}
+	// Step 2
+	else{
+		struct avl_template_t* next = min_avl_tree_node(node->right);
+		if(next->parent == node) rebalance_from = next;
+		else{
+			rebalance_from = next->parent;
+			replace_avl_tree_child(root_ptr,next->parent,next,next->right);
+			next->right = node->right;
+			next->right->parent = next;
+		}
+		next->left = node->left;
+		next->left->parent = next;
+		replace_avl_tree_child(root_ptr,node->parent,node,next);
+		next->height = node->height;
+	}
+	rebalance_avl_tree(root_ptr,rebalance_from);
+	node->left = node->right = node->parent = NULL;
+	node->height = 1;
+	BINARY_TREE_FREE_NODE(n);
+}
+
+// Parse through every node of an AVL tree in order, without recursion
+// First arg is the root node (a pointer to the node type)
+// Second arg is the code to be executed for each node, the local variable avl_node is a pointer to it
+// The node being parsed can't be removed
+#define parse_avl_tree(r,c) ({\
+	for(typeof((r)) avl_node = min_avl_tree_node((r)); avl_node; avl_node = next_avl_tree_node(avl_node)){\
+		(c);\
+	}\
+})
+
+#endif
@@ -39,6 +39,7 @@ binary_tree_with(int value) int_binary_tree;
 
 // Macro that is called when a binary tree node is removed or should be freed
 // Override with what you want it to be
+// (to allocate the nodes from a node pool, see "node_pool.h")
 #ifndef BINARY_TREE_FREE_NODE
 #define BINARY_TREE_FREE_NODE(n)
 #endif
@@ -49,17 +50,168 @@ struct bt_template_t{
 	void* right;
 };
 
-// Free children nodes from the parent node, recursively
+// You can overwrite these macros, to allocate the stacks used to walk through trees without recursion
+#ifndef BINARY_TREE_REALLOC
+#include <stdlib.h>
+#define BINARY_TREE_REALLOC(ptr, sz) realloc((ptr),(sz))
+#endif
+
+#ifndef BINARY_TREE_FREE
+#include <stdlib.h>
+#define BINARY_TREE_FREE(ptr) free((ptr))
+#endif
+
+// Amount of nodes a stack holds before it allocates memory
+// 64 is enough for any balanced tree, deeper ones (like a sorted tree built from sorted nodes) grow the stack
+#ifndef BINARY_TREE_STACK_SIZE
+#define BINARY_TREE_STACK_SIZE 64
+#endif
+
+#include <stddef.h>
+#include <string.h>
+
+// The stack of nodes used by the parsing macros below (it is also used as a queue by parse_binary_tree_level_order)
+typedef struct {
+	void** nodes; // Allocated nodes, NULL while the inline ones are used
+	size_t start; // Index of the first node (only moves when used as a queue)
+	size_t size; // Amount of nodes in it
+	size_t capacity; // Amount of nodes it can hold
+	void* inline_nodes[BINARY_TREE_STACK_SIZE];
+} binary_tree_stack_t;
+
+// Create an empty stack
+#define create_binary_tree_stack() {NULL,0,0,BINARY_TREE_STACK_SIZE,{NULL}}
+
+// Get the nodes of a stack
+#define binary_tree_stack_nodes(s) ((s)->nodes ? (s)->nodes : (s)->inline_nodes)
+
+// Add a node at the end of a stack
+void push_binary_tree_stack(binary_tree_stack_t* s, void* node){
+	if(s->start+s->size == s->capacity){
+		// Move the nodes back to the start when most of the space before them is unused, else grow the stack
+		if(s->start >= s->capacity/2){
+			memmove(binary_tree_stack_nodes(s),binary_tree_stack_nodes(s)+s->start,sizeof(void*)*s->size);
+			s->start = 0;
+		}else{
+			s->capacity *= 2;
+			void** nodes = BINARY_TREE_REALLOC(s->nodes,sizeof(void*)*s->capacity);
+			if(s->nodes == NULL) memcpy(nodes,s->inline_nodes,sizeof(void*)*(s->start+s->size));
+			s->nodes = nodes;
+		}
+	}
+	binary_tree_stack_nodes(s)[s->start+s->size++] = node;
+}
+
+// Remove the last node of a stack, and get it (NULL if the stack is empty)
+void* pop_binary_tree_stack(binary_tree_stack_t* s){
+	if(s->size == 0) return NULL;
+	return binary_tree_stack_nodes(s)[s->start+--s->size];
+}
+
+// Get the last node of a stack, without removing it (NULL if the stack is empty)
+void* top_binary_tree_stack(binary_tree_stack_t* s){
+	if(s->size == 0) return NULL;
+	return binary_tree_stack_nodes(s)[s->start+s->size-1];
+}
+
+// Remove the first node of a stack, and get it (NULL if the stack is empty)
+void* shift_binary_tree_stack(binary_tree_stack_t* s){
+	if(s->size == 0) return NULL;
+	void* node = binary_tree_stack_nodes(s)[s->start++];
+	if(--s->size == 0) s->start = 0;
+	return node;
+}
+
+// Free a stack
+void free_binary_tree_stack(binary_tree_stack_t* s){
+	if(s->nodes) BINARY_TREE_FREE(s->nodes);
+	s->nodes = NULL;
+	s->start = s->size = 0;
+	s->capacity = BINARY_TREE_STACK_SIZE;
+}
+
+// Parse through every node of a tree, without recursion
+// First arg is the root node (a pointer to the node type), second arg is the code to be executed for each node
+// The local variable bt_node is a pointer to the node you are parsing
+// You can use break to stop parsing, but not return (the stack would not be freed)
+// 	* in order : left subtree, node, right subtree (the nodes of a sorted tree, sorted)
+// 	* pre order : node, left subtree, right subtree (parents before their children)
+// 	* post order : left subtree, right subtree, node (children before their parents)
+// 	* level order : root, its children, their children... (breadth first)
+// The pre order, post order and level order macros are done with a node before the code is executed, so it can be freed
+/* EXAMPLE:
+
+int sum = 0;
+parse_binary_tree_in_order(root,({
+	sum += bt_node->number;
+}));
+
+*/
+#define parse_binary_tree_in_order(r,c) ({\
+	binary_tree_stack_t bt_stack = create_binary_tree_stack();\
+	typeof((r)) bt_next = (r);\
+	while(bt_next || bt_stack.size){\
+		while(bt_next){\
+			push_binary_tree_stack(&bt_stack,bt_next);\
+			bt_next = bt_next->left;\
+		}\
+		typeof((r)) bt_node = pop_binary_tree_stack(&bt_stack);\
+		bt_next = bt_node->right;\
+		(c);\
+	}\
+	free_binary_tree_stack(&bt_stack);\
+})
+#define parse_binary_tree_pre_order(r,c) ({\
+	binary_tree_stack_t bt_stack = create_binary_tree_stack();\
+	if((r)) push_binary_tree_stack(&bt_stack,(r));\
+	while(bt_stack.size){\
+		typeof((r)) bt_node = pop_binary_tree_stack(&bt_stack);\
+		if(bt_node->right) push_binary_tree_stack(&bt_stack,bt_node->right);\
+		if(bt_node->left) push_binary_tree_stack(&bt_stack,bt_node->left);\
+		(c);\
+	}\
+	free_binary_tree_stack(&bt_stack);\
+})
+#define parse_binary_tree_post_order(r,c) ({\
+	binary_tree_stack_t bt_stack = create_binary_tree_stack();\
+	typeof((r)) bt_next = (r);\
+	void* bt_last = NULL;\
+	while(bt_next || bt_stack.size){\
+		if(bt_next){\
+			push_binary_tree_stack(&bt_stack,bt_next);\
+			bt_next = bt_next->left;\
+			continue;\
+		}\
+		typeof((r)) bt_top = top_binary_tree_stack(&bt_stack);\
+		if(bt_top->right && bt_top->right != bt_last){\
+			bt_next = bt_top->right;\
+			continue;\
+		}\
+		typeof((r)) bt_node = pop_binary_tree_stack(&bt_stack);\
+		bt_last = bt_node;\
+		(c);\
+	}\
+	free_binary_tree_stack(&bt_stack);\
+})
+#define parse_binary_tree_level_order(r,c) ({\
+	binary_tree_stack_t bt_stack = create_binary_tree_stack();\
+	if((r)) push_binary_tree_stack(&bt_stack,(r));\
+	while(bt_stack.size){\
+		typeof((r)) bt_node = shift_binary_tree_stack(&bt_stack);\
+		if(bt_node->left) push_binary_tree_stack(&bt_stack,bt_node->left);\
+		if(bt_node->right) push_binary_tree_stack(&bt_stack,bt_node->right);\
+		(c);\
+	}\
+	free_binary_tree_stack(&bt_stack);\
+})
+
+// Free children nodes from the parent node, without recursion
 // Pass root node to free the entire tree
 void free_binary_tree(void* parent_ptr){
-	if(parent_ptr){
-		struct bt_template_t* parent = (struct bt_template_t*) parent_ptr;
-		if(parent->left)
-			free_binary_tree(parent->left);
-		if(parent->right)
-			free_binary_tree(parent->right);
-		BINARY_TREE_FREE_NODE(parent_ptr);
-	}
+	struct bt_template_t* parent = parent_ptr;
+	parse_binary_tree_pre_order(parent,({
+		BINARY_TREE_FREE_NODE(bt_node);
+	}));
 }
 
 // Access left / right member of tree node
@@ -73,7 +225,6 @@ void free_binary_tree(void* parent_ptr){
 // 2. The potential parent node
 // It needs to return a _Bool (aka bool)
 // if false, will try to add node as left child, if true, will try add node as right child
-// Recursive
 /* EXAMPLE
 _Bool check_bigger(void* p, void* n){
 	return ((node*)(n))->number > ((node*)(p))->number;
@@ -84,20 +235,112 @@ add_binary_tree_node(root_node,new_node,check_bigger);
 */
 void add_binary_tree_node(void* parent_ptr, void* node_ptr, _Bool (*comparison_func)(void*,void*)){
 	if(parent_ptr == NULL || node_ptr == NULL) return;
-	struct bt_template_t *parent = parent_ptr, *node = node_ptr;
-	if(comparison_func(parent_ptr,node_ptr)){
-		if(parent->right)
-			add_binary_tree_node(parent->right,node,comparison_func);
-		else
-			parent->right = node;
-	}else{
-		if(parent->left)
-			add_binary_tree_node(parent->left,node,comparison_func);
-		else
-			parent->left = node;
+	struct bt_template_t* parent = parent_ptr;
+	while(1){
+		void** child = comparison_func(parent,node_ptr) ? &parent->right : &parent->left;
+		if(*child == NULL){
+			*child = node_ptr;
+			return;
+		}
+		parent = *child;
+	}
+}
+
+// Find a node equal to key in a sorted binary tree (NULL if there is none)
+// key is a node with the members used by the comparison function set
+// Two nodes are equal when neither goes after the other
+void* find_binary_tree_node(void* root, void* key, _Bool (*comparison_func)(void*,void*)){
+	struct bt_template_t* current = root;
+	while(current){
+		if(comparison_func(current,key)) current = current->right;
+		else if(comparison_func(key,current)) current = current->left;
+		else return current;
+	}
+	return NULL;
+}
+
+// Macro that is called by erase_binary_tree_node once a node is unlinked from the tree
+// (r) is a pointer to the variable holding the root node, (p) is the deepest node whose children changed (NULL for the root)
+// Override it to rebalance the tree (see "avl_tree.h" for a tree that is always balanced)
+#ifndef BINARY_TREE_REBALANCE
+#define BINARY_TREE_REBALANCE(r,p) ({ (void)(r); (void)(p); })
+#endif
+
+// Remove node n from a sorted binary tree, then call BINARY_TREE_FREE_NODE on it
+// root is a pointer to the variable holding the root node (it changes when the root is removed)
+// n is found with the comparison function, like add_binary_tree_node does, nothing happens if it isn't in the tree
+// 1. If n has less than 2 children, its child (or nothing) takes its place
+// 2. Else, the node right before it (the biggest of its left subtree) takes its place,
+// 	so nodes equal to it stay on the left, where add_binary_tree_node puts them
+// Nodes are moved, not copied, so the pointers to the other nodes stay valid
+void erase_binary_tree_node(void* root, void* n, _Bool (*comparison_func)(void*,void*)){
+	if(n == NULL) return;
+	void** link = root; // The pointer to the current node, in its parent (or the root variable)
+	struct bt_template_t *node, *parent = NULL, *changed;
+	while((node = *link) && node != n){
+		parent = node;
+		link = comparison_func(node,n) ? &node->right : &node->left;
+	}
+	if(node == NULL) return;
+	// Step 1
+	if(node->left == NULL || node->right == NULL){
+		*link = node->left ? node->left : node->right;
+		changed = parent;
 	}
+	// Step 2
+	else{
+		void** previous_link = &node->left;
+		struct bt_template_t *previous, *previous_parent = node;
+		while(((struct bt_template_t*)*previous_link)->right){
+			previous_parent = *previous_link;
+			previous_link = &previous_parent->right;
+		}
+		previous = *previous_link;
+		*previous_link = previous->left;
+		previous->left = node->left;
+		previous->right = node->right;
+		*link = previous;
+		changed = previous_parent == node ? previous : previous_parent;
+	}
+	BINARY_TREE_REBALANCE(root,changed);
+	node->left = node->right = NULL;
+	BINARY_TREE_FREE_NODE(n);
 }
 
+// Parse through the nodes of a sorted binary tree that are in the range [lo,hi), in order, without recursion
+// lo and hi are nodes with the members used by the comparison function set
+// The subtrees that are out of the range are skipped, and parsing stops at the first node that is not before hi
+// Last arg is the code to be executed for each node, the local variable bt_node is a pointer to it (see parse_binary_tree_in_order)
+/* EXAMPLE:
+
+node lo = create_binary_tree_node(10), hi = create_binary_tree_node(20);
+parse_binary_tree_range(root_node,&lo,&hi,check_bigger,({
+	printf("%d\n",bt_node->number); // 10 to 19
+}));
+
+*/
+#define parse_binary_tree_range(r,lo,hi,f,c) ({\
+	binary_tree_stack_t bt_stack = create_binary_tree_stack();\
+	void *bt_lo = (lo), *bt_hi = (hi);\
+	_Bool (*bt_cmp)(void*,void*) = (f);\
+	typeof((r)) bt_next = (r);\
+	while(bt_next || bt_stack.size){\
+		while(bt_next){\
+			if(bt_cmp(bt_next,bt_lo)) bt_next = bt_next->right;\
+			else{\
+				push_binary_tree_stack(&bt_stack,bt_next);\
+				bt_next = bt_next->left;\
+			}\
+		}\
+		if(bt_stack.size == 0) break;\
+		typeof((r)) bt_node = pop_binary_tree_stack(&bt_stack);\
+		if(!bt_cmp(bt_node,bt_hi)) break;\
+		bt_next = bt_node->right;\
+		(c);\
+	}\
+	free_binary_tree_stack(&bt_stack);\
+})
+
 // Cursor movement and clearing the terminal
 #define BINARY_TREE_CURSOR(x,y) printf("\033[%d;%dH",(y),(x))
 #define BINARY_TREE_CLEAR() printf("\e[1;1H\e[2J")
@@ -0,0 +1,502 @@
+#ifndef CDS_BPLUS_TREE_H
+#define CDS_BPLUS_TREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// A B+ tree is a sorted tree where each node holds many elements, for big sorted sets of elements
+// A binary tree node holds one element and two pointers, each in its own allocation, so finding an element
+// among millions goes through ~20 nodes, usually one cache miss each
+// A B+ tree node is a few cache lines holding as many keys as they can fit, so the tree is only a few levels deep:
+// - The elements are all in the leaves (the last level), sorted, and each leaf points to the next one
+// - The other nodes (internal nodes) hold keys: copies of the first element of their children (except the first one)
+// 	and a pointer to each child, to find in which child an element is
+// Every node except the root is always at least half full (nodes are split when full, merged when less than half full)
+//
+// Here is how it looks like with 3 elements per leaf:
+//
+// 	root   :            [4 7]
+// 	leaves : [1 2 3] -> [4 5 6] -> [7 8 -]
+//
+// The root has 3 children: the leaf before 4, the leaf from 4 to 7 (not included), and the leaf from 7
+//
+// The elements are stored in the tree (copied), and are sorted with a comparison function,
+// like add_binary_tree_node (see binary_tree.h):
+// it takes two elements (p and n) and returns true if n goes after p
+// Two elements are equal when neither goes after the other, and a tree never holds two equal elements
+/* EXAMPLE:
+
+typedef struct {
+	long timestamp;
+	int value;
+} event_t;
+
+_Bool event_after(void* p, void* n){
+	return ((event_t*)n)->timestamp > ((event_t*)p)->timestamp;
+}
+
+bplus_tree_t events = create_bplus_tree(event_t,event_after);
+for(long t = 0; t < 1000000; t++) add_bplus_tree(&events,&(event_t){t,0});
+event_t key = {500000,0};
+event_t* found = find_bplus_tree(&events,&key);
+remove_bplus_tree(&events,&key);
+free_bplus_tree(&events);
+
+*/
+
+// Size of a node, in bytes (a multiple of BPLUS_TREE_ALIGN)
+// The amount of elements or keys in a node is computed from it, and is at least 3
+// An internal node also holds a pointer per child, so it holds fewer keys than a leaf holds elements:
+// with 256 bytes, a leaf holds 60 ints and an internal node 18 (19 children)
+#ifndef BPLUS_TREE_NODE_SIZE
+#define BPLUS_TREE_NODE_SIZE 256
+#endif
+
+// Nodes are aligned to cache lines
+#define BPLUS_TREE_ALIGN 64
+
+// Maximum height of a tree (more than any tree that fits in memory)
+#define BPLUS_TREE_MAX_HEIGHT 64
+
+// You can overwrite these macros, to allocate the nodes
+// The sizes given to BPLUS_TREE_ALLOC are always multiples of BPLUS_TREE_ALIGN
+#ifndef BPLUS_TREE_ALLOC
+#include <stdlib.h>
+#define BPLUS_TREE_ALLOC(sz) aligned_alloc(BPLUS_TREE_ALIGN,(sz))
+#endif
+
+#ifndef BPLUS_TREE_FREE
+#include <stdlib.h>
+#define BPLUS_TREE_FREE(ptr) free((ptr))
+#endif
+
+// A node of a B+ tree
+// A leaf holds count elements, an internal node holds count keys and count+1 children
+// (the pointers to the children first, then the keys)
+typedef struct bplus_node_t{
+	struct bplus_node_t* next; // Next leaf (NULL for the last leaf and for the internal nodes)
+	uint32_t count; // Amount of elements of a leaf / keys of an internal node
+	uint32_t leaf; // 1 for a leaf, 0 for an internal node
+	_Alignas(max_align_t) char data[];
+} bplus_node_t;
+
+// The B+ tree structure
+typedef struct {
+	bplus_node_t* root; // Root node (NULL when the tree is empty)
+	bplus_node_t* first; // First leaf
+	size_t size; // Amount of elements in the tree
+	uint32_t height; // Amount of levels (0 when the tree is empty, 1 when the root is a leaf)
+	uint32_t leaf_capacity; // Amount of elements a leaf can hold
+	uint32_t internal_capacity; // Amount of keys an internal node can hold
+	size_t leaf_size; // Size of a leaf, in bytes
+	size_t internal_size; // Size of an internal node, in bytes
+	size_t keys_offset; // Offset of the keys in the data of an internal node
+	size_t element_size; // Size of the elements, in bytes
+	_Bool (*comparison_func)(void*,void*); // The comparison function
+} bplus_tree_t;
+
+// Element i of a leaf / key i and children of an internal node
+#define bplus_tree_element(t,n,i) ((void*)((n)->data+(size_t)(i)*(t)->element_size))
+#define bplus_tree_key(t,n,i) ((void*)((n)->data+(t)->keys_offset+(size_t)(i)*(t)->element_size))
+#define bplus_tree_children(n) ((bplus_node_t**)(n)->data)
+
+/*
+Creates a B+ tree with nothing in it
+The macro takes the type of the elements, the function takes their size
+Will set the comparison function to the value of f
+*/
+#define create_bplus_tree(t,f) create_bplus_tree_ex(sizeof(t),(f))
+bplus_tree_t create_bplus_tree_ex(size_t element_size, _Bool (*comparison_func)(void*,void*)){
+	bplus_tree_t t = {0};
+	t.element_size = element_size;
+	t.comparison_func = comparison_func;
+	size_t header = offsetof(bplus_node_t,data), align = _Alignof(max_align_t);
+	// Leaves: the elements
+	size_t capacity = BPLUS_TREE_NODE_SIZE > header ? (BPLUS_TREE_NODE_SIZE-header)/element_size : 0;
+	if(capacity < 3) capacity = 3;
+	t.leaf_capacity = capacity;
+	t.leaf_size = (header+capacity*element_size+BPLUS_TREE_ALIGN-1) & ~(size_t)(BPLUS_TREE_ALIGN-1);
+	// Internal nodes: capacity+1 pointers, padding, then the keys
+	size_t used = header+sizeof(void*)+align;
+	capacity = BPLUS_TREE_NODE_SIZE > used ? (BPLUS_TREE_NODE_SIZE-used)/(element_size+sizeof(void*)) : 0;
+	if(capacity < 3) capacity = 3;
+	t.internal_capacity = capacity;
+	t.keys_offset = ((capacity+1)*sizeof(void*)+align-1) & ~(align-1);
+	t.internal_size = (header+t.keys_offset+capacity*element_size+BPLUS_TREE_ALIGN-1) & ~(size_t)(BPLUS_TREE_ALIGN-1);
+	return t;
+}
+
+// Allocate an empty node
+bplus_node_t* bplus_tree_new_node(bplus_tree_t* t, _Bool leaf){
+	bplus_node_t* n = BPLUS_TREE_ALLOC(leaf ? t->leaf_size : t->internal_size);
+	n->next = NULL;
+	n->count = 0;
+	n->leaf = leaf;
+	return n;
+}
+
+// Free a node and all of its children
+void bplus_tree_free_node(bplus_node_t* n){
+	if(!n->leaf){
+		for(uint32_t i = 0; i <= n->count; i++) bplus_tree_free_node(bplus_tree_children(n)[i]);
+	}
+	BPLUS_TREE_FREE(n);
+}
+
+// Frees a B+ tree (it can be used again afterwards)
+void free_bplus_tree(bplus_tree_t* t){
+	if(t->root) bplus_tree_free_node(t->root);
+	t->root = t->first = NULL;
+	t->size = 0;
+	t->height = 0;
+}
+
+// Get the index of the child of internal node n where key is (the amount of keys of n that are not after key)
+uint32_t bplus_tree_child_index(bplus_tree_t* t, bplus_node_t* n, void* key){
+	uint32_t low = 0, high = n->count;
+	while(low < high){
+		uint32_t middle = (low+high)/2;
+		if(t->comparison_func(key,bplus_tree_key(t,n,middle))) high = middle;
+		else low = middle+1;
+	}
+	return low;
+}
+
+// Get the index of the first element of leaf n that is not before key (its count if there is none)
+uint32_t bplus_tree_leaf_index(bplus_tree_t* t, bplus_node_t* n, void* key){
+	uint32_t low = 0, high = n->count;
+	while(low < high){
+		uint32_t middle = (low+high)/2;
+		if(t->comparison_func(bplus_tree_element(t,n,middle),key)) low = middle+1;
+		else high = middle;
+	}
+	return low;
+}
+
+// Go down to the leaf where key is (the tree must not be empty)
+// If path isn't NULL, the nodes above the leaf are put in it, and the index of the child taken in each one in slots
+bplus_node_t* bplus_tree_find_leaf(bplus_tree_t* t, void* key, bplus_node_t** path, uint32_t* slots){
+	bplus_node_t* n = t->root;
+	for(uint32_t depth = 0; depth+1 < t->height; depth++){
+		uint32_t i = bplus_tree_child_index(t,n,key);
+		if(path){
+			path[depth] = n;
+			slots[depth] = i;
+		}
+		n = bplus_tree_children(n)[i];
+	}
+	return n;
+}
+
+// Find an element equal to key in a B+ tree, and get a pointer to it (NULL if there is none)
+// key is an element with the members used by the comparison function set
+// The element can be changed through the pointer, as long as its place in the tree stays the same
+void* find_bplus_tree(bplus_tree_t* t, void* key){
+	if(t->root == NULL) return NULL;
+	bplus_node_t* leaf = bplus_tree_find_leaf(t,key,NULL,NULL);
+	uint32_t i = bplus_tree_leaf_index(t,leaf,key);
+	if(i < leaf->count && !t->comparison_func(key,bplus_tree_element(t,leaf,i))) return bplus_tree_element(t,leaf,i);
+	return NULL;
+}
+
+// Get the leaf and the index in it of the first element that is not before key (NULL if there is none)
+bplus_node_t* bplus_tree_lower_bound_leaf(bplus_tree_t* t, void* key, uint32_t* index){
+	if(t->root == NULL) return NULL;
+	bplus_node_t* leaf = bplus_tree_find_leaf(t,key,NULL,NULL);
+	*index = bplus_tree_leaf_index(t,leaf,key);
+	// It is the first element of the next leaf when every element of this one is before key
+	if(*index == leaf->count){
+		leaf = leaf->next;
+		*index = 0;
+	}
+	return leaf;
+}
+
+// Get a pointer to the first element of a B+ tree that is not before key (NULL if there is none)
+void* lower_bound_bplus_tree(bplus_tree_t* t, void* key){
+	uint32_t i;
+	bplus_node_t* leaf = bplus_tree_lower_bound_leaf(t,key,&i);
+	return leaf ? bplus_tree_element(t,leaf,i) : NULL;
+}
+
+// Insert element e at index i of leaf n (n must not be full)
+void bplus_tree_insert_element(bplus_tree_t* t, bplus_node_t* n, uint32_t i, void* e){
+	memmove(bplus_tree_element(t,n,i+1),bplus_tree_element(t,n,i),(n->count-i)*t->element_size);
+	memcpy(bplus_tree_element(t,n,i),e,t->element_size);
+	n->count++;
+}
+
+// Insert key k at index i of internal node n, with child c right after it (n must not be full)
+void bplus_tree_insert_key(bplus_tree_t* t, bplus_node_t* n, uint32_t i, void* k, bplus_node_t* c){
+	memmove(bplus_tree_key(t,n,i+1),bplus_tree_key(t,n,i),(n->count-i)*t->element_size);
+	memcpy(bplus_tree_key(t,n,i),k,t->element_size);
+	memmove(bplus_tree_children(n)+i+2,bplus_tree_children(n)+i+1,(n->count-i)*sizeof(void*));
+	bplus_tree_children(n)[i+1] = c;
+	n->count++;
+}
+
+// Add key k and node c (the new right half of the node at depth d of path, that was split) to the nodes above it
+// When the parent is full, it is split too, and so on up to the root
+void bplus_tree_insert_parent(bplus_tree_t* t, bplus_node_t** path, uint32_t* slots, uint32_t d, void* k, bplus_node_t* c){
+	for(; d > 0; d--){
+		bplus_node_t* n = path[d-1];
+		uint32_t s = slots[d-1];
+		if(n->count < t->internal_capacity){
+			bplus_tree_insert_key(t,n,s,k,c);
+			return;
+		}
+		// Split n: with k and c, it has capacity+1 keys (k is key s, c is child s+1)
+		// The keys after the middle one and their children go to a new node, the middle key goes up
+		uint32_t total = t->internal_capacity+1, middle = total/2;
+		bplus_node_t* right = bplus_tree_new_node(t,0);
+		bplus_node_t **children = bplus_tree_children(n), **right_children = bplus_tree_children(right);
+		for(uint32_t j = middle+1; j < total; j++){
+			memcpy(bplus_tree_key(t,right,j-middle-1),j == s ? k : bplus_tree_key(t,n,j < s ? j : j-1),t->element_size);
+		}
+		for(uint32_t j = middle+1; j <= total; j++){
+			right_children[j-middle-1] = j == s+1 ? c : children[j <= s ? j : j-1];
+		}
+		right->count = total-middle-1;
+		// The middle key is kept in the last key of n, which isn't used anymore
+		void* up = bplus_tree_key(t,n,t->internal_capacity-1);
+		memmove(up,middle == s ? k : bplus_tree_key(t,n,middle < s ? middle : middle-1),t->element_size);
+		if(s < middle){
+			n->count = middle-1;
+			bplus_tree_insert_key(t,n,s,k,c);
+		}
+		else n->count = middle;
+		k = up;
+		c = right;
+	}
+	// The root was split, add a new root above it
+	bplus_node_t* root = bplus_tree_new_node(t,0);
+	memcpy(bplus_tree_key(t,root,0),k,t->element_size);
+	bplus_tree_children(root)[0] = t->root;
+	bplus_tree_children(root)[1] = c;
+	root->count = 1;
+	t->root = root;
+	t->height++;
+}
+
+// Add a copy of element e to a B+ tree
+// Returns 0 if an element equal to e is already in the tree (it is not replaced, use find_bplus_tree to change it)
+_Bool add_bplus_tree(bplus_tree_t* t, void* e){
+	if(t->root == NULL){
+		t->root = t->first = bplus_tree_new_node(t,1);
+		t->height = 1;
+	}
+	bplus_node_t* path[BPLUS_TREE_MAX_HEIGHT];
+	uint32_t slots[BPLUS_TREE_MAX_HEIGHT];
+	bplus_node_t* leaf = bplus_tree_find_leaf(t,e,path,slots);
+	uint32_t i = bplus_tree_leaf_index(t,leaf,e);
+	if(i < leaf->count && !t->comparison_func(e,bplus_tree_element(t,leaf,i))) return 0;
+	t->size++;
+	if(leaf->count < t->leaf_capacity){
+		bplus_tree_insert_element(t,leaf,i,e);
+		return 1;
+	}
+	// Split the leaf: the first half of the elements (with e) stays in it, the other half goes to a new leaf
+	uint32_t middle = (t->leaf_capacity+1)/2, from = i < middle ? middle-1 : middle;
+	bplus_node_t* right = bplus_tree_new_node(t,1);
+	memcpy(right->data,bplus_tree_element(t,leaf,from),(leaf->count-from)*t->element_size);
+	right->count = leaf->count-from;
+	leaf->count = from;
+	if(i < middle) bplus_tree_insert_element(t,leaf,i,e);
+	else bplus_tree_insert_element(t,right,i-from,e);
+	right->next = leaf->next;
+	leaf->next = right;
+	bplus_tree_insert_parent(t,path,slots,t->height-1,right->data,right);
+	return 1;
+}
+
+// Move the last element / key of node l (child s-1 of p) to the start of node n (child s of p)
+void bplus_tree_borrow_left(bplus_tree_t* t, bplus_node_t* p, uint32_t s, bplus_node_t* n, bplus_node_t* l){
+	if(n->leaf){
+		bplus_tree_insert_element(t,n,0,bplus_tree_element(t,l,l->count-1));
+		l->count--;
+		memcpy(bplus_tree_key(t,p,s-1),n->data,t->element_size);
+		return;
+	}
+	memmove(bplus_tree_key(t,n,1),bplus_tree_key(t,n,0),n->count*t->element_size);
+	memmove(bplus_tree_children(n)+1,bplus_tree_children(n),(n->count+1)*sizeof(void*));
+	memcpy(bplus_tree_key(t,n,0),bplus_tree_key(t,p,s-1),t->element_size);
+	bplus_tree_children(n)[0] = bplus_tree_children(l)[l->count];
+	memcpy(bplus_tree_key(t,p,s-1),bplus_tree_key(t,l,l->count-1),t->element_size);
+	l->count--;
+	n->count++;
+}
+
+// Move the first element / key of node r (child s+1 of p) to the end of node n (child s of p)
+void bplus_tree_borrow_right(bplus_tree_t* t, bplus_node_t* p, uint32_t s, bplus_node_t* n, bplus_node_t* r){
+	if(n->leaf){
+		memcpy(bplus_tree_element(t,n,n->count++),r->data,t->element_size);
+		memmove(r->data,bplus_tree_element(t,r,1),--r->count*t->element_size);
+		memcpy(bplus_tree_key(t,p,s),r->data,t->element_size);
+		return;
+	}
+	memcpy(bplus_tree_key(t,n,n->count),bplus_tree_key(t,p,s),t->element_size);
+	bplus_tree_children(n)[n->count+1] = bplus_tree_children(r)[0];
+	memcpy(bplus_tree_key(t,p,s),bplus_tree_key(t,r,0),t->element_size);
+	memmove(bplus_tree_key(t,r,0),bplus_tree_key(t,r,1),(r->count-1)*t->element_size);
+	memmove(bplus_tree_children(r),bplus_tree_children(r)+1,r->count*sizeof(void*));
+	r->count--;
+	n->count++;
+}
+
+// Move everything in node r (child s+1 of p) to the end of node l (child s of p), and free r
+void bplus_tree_merge(bplus_tree_t* t, bplus_node_t* p, uint32_t s, bplus_node_t* l, bplus_node_t* r){
+	if(l->leaf){
+		memcpy(bplus_tree_element(t,l,l->count),r->data,r->count*t->element_size);
+		l->count += r->count;
+		l->next = r->next;
+	}else{
+		// The key between them in p comes down between their keys
+		memcpy(bplus_tree_key(t,l,l->count),bplus_tree_key(t,p,s),t->element_size);
+		memcpy(bplus_tree_key(t,l,l->count+1),bplus_tree_key(t,r,0),r->count*t->element_size);
+		memcpy(bplus_tree_children(l)+l->count+1,bplus_tree_children(r),(r->count+1)*sizeof(void*));
+		l->count += r->count+1;
+	}
+	BPLUS_TREE_FREE(r);
+	memmove(bplus_tree_key(t,p,s),bplus_tree_key(t,p,s+1),(p->count-s-1)*t->element_size);
+	memmove(bplus_tree_children(p)+s+1,bplus_tree_children(p)+s+2,(p->count-s-1)*sizeof(void*));
+	p->count--;
+}
+
+// Remove the element equal to key from a B+ tree
+// Returns 0 if there is none
+// When a node gets less than half full, it takes an element from one of its siblings, or is merged with it
+_Bool remove_bplus_tree(bplus_tree_t* t, void* key){
+	if(t->root == NULL) return 0;
+	bplus_node_t* path[BPLUS_TREE_MAX_HEIGHT];
+	uint32_t slots[BPLUS_TREE_MAX_HEIGHT];
+	bplus_node_t* n = bplus_tree_find_leaf(t,key,path,slots);
+	uint32_t i = bplus_tree_leaf_index(t,n,key);
+	if(i == n->count || t->comparison_func(key,bplus_tree_element(t,n,i))) return 0;
+	memmove(bplus_tree_element(t,n,i),bplus_tree_element(t,n,i+1),(n->count-i-1)*t->element_size);
+	n->count--;
+	t->size--;
+	for(uint32_t d = t->height-1; d > 0; d--){
+		uint32_t min = (n->leaf ? t->leaf_capacity : t->internal_capacity)/2;
+		if(n->count >= min) return 1;
+		bplus_node_t* p = path[d-1];
+		uint32_t s = slots[d-1];
+		bplus_node_t* left = s > 0 ? bplus_tree_children(p)[s-1] : NULL;
+		bplus_node_t* right = s < p->count ? bplus_tree_children(p)[s+1] : NULL;
+		if(left && left->count > min){
+			bplus_tree_borrow_left(t,p,s,n,left);
+			return 1;
+		}
+		if(right && right->count > min){
+			bplus_tree_borrow_right(t,p,s,n,right);
+			return 1;
+		}
+		if(left) bplus_tree_merge(t,p,s-1,left,n);
+		else bplus_tree_merge(t,p,s,n,right);
+		n = p;
+	}
+	// n is the root, remove it when it is empty (or when it only has one child left)
+	if(n->count == 0){
+		if(n->leaf){
+			t->root = t->first = NULL;
+			t->height = 0;
+		}else{
+			t->root = bplus_tree_children(n)[0];
+			t->height--;
+		}
+		BPLUS_TREE_FREE(n);
+	}
+	return 1;
+}
+
+// Get the first element of a node and its children
+void* bplus_tree_min(bplus_node_t* n){
+	while(!n->leaf) n = bplus_tree_children(n)[0];
+	return n->data;
+}
+
+// Replace everything in a B+ tree with count elements, from an array (copied)
+// The elements must be sorted, with no two elements equal
+// Much faster than adding them one by one: the leaves are filled in order, as full as they can be,
+// then each level is built above the previous one
+void build_bplus_tree(bplus_tree_t* t, void* elements, size_t count){
+	free_bplus_tree(t);
+	if(count == 0) return;
+	// The leaves, with the elements spread evenly between them
+	size_t nodes = (count+t->leaf_capacity-1)/t->leaf_capacity;
+	char* from = elements;
+	bplus_node_t* last = NULL;
+	for(size_t i = 0; i < nodes; i++){
+		bplus_node_t* leaf = bplus_tree_new_node(t,1);
+		leaf->count = count/nodes+(i < count%nodes);
+		memcpy(leaf->data,from,leaf->count*t->element_size);
+		from += leaf->count*t->element_size;
+		if(last) last->next = leaf;
+		else t->first = leaf;
+		last = leaf;
+	}
+	t->size = count;
+	t->height = 1;
+	// The internal nodes, level by level (the nodes of the level being built are linked with .next for now)
+	bplus_node_t* level = t->first;
+	while(nodes > 1){
+		size_t parents = (nodes+t->internal_capacity)/(t->internal_capacity+1);
+		bplus_node_t *child = level, *first = NULL;
+		last = NULL;
+		for(size_t i = 0; i < parents; i++){
+			bplus_node_t* p = bplus_tree_new_node(t,0);
+			size_t children = nodes/parents+(i < nodes%parents);
+			for(size_t j = 0; j < children; j++){
+				bplus_tree_children(p)[j] = child;
+				if(j) memcpy(bplus_tree_key(t,p,j-1),bplus_tree_min(child),t->element_size);
+				bplus_node_t* next = child->next;
+				if(!child->leaf) child->next = NULL;
+				child = next;
+			}
+			p->count = children-1;
+			if(last) last->next = p;
+			else first = p;
+			last = p;
+		}
+		level = first;
+		nodes = parents;
+		t->height++;
+	}
+	if(!level->leaf) level->next = NULL;
+	t->root = level;
+}
+
+// Build a B+ tree from a sorted vector (see vector.h), the elements are copied
+#define build_vector_bplus_tree(t,v) build_bplus_tree((t),(v).arr,(v).size)
+
+// Parse through the elements of a B+ tree in the range [lo,hi), in order, going from leaf to leaf
+// lo and hi are elements with the members used by the comparison function set,
+// lo can be NULL to start from the first element, and hi NULL to go up to the last one
+// Last arg is the code to be executed for each element, the local variable bp_element is a void pointer to it
+// You can use break to stop parsing, elements can't be added or removed while parsing
+/* EXAMPLE:
+
+event_t from = {1000,0}, to = {2000,0};
+parse_bplus_tree(&events,&from,&to,({
+	printf("%ld\n",((event_t*)bp_element)->timestamp);
+}));
+
+*/
+#define parse_bplus_tree(t,lo,hi,c) ({\
+	bplus_tree_t* bp_tree = (t);\
+	void *bp_lo = (lo), *bp_hi = (hi);\
+	uint32_t bp_i = 0;\
+	bplus_node_t* bp_leaf = bp_lo ? bplus_tree_lower_bound_leaf(bp_tree,bp_lo,&bp_i) : bp_tree->first;\
+	while(bp_leaf){\
+		if(bp_i == bp_leaf->count){\
+			bp_leaf = bp_leaf->next;\
+			bp_i = 0;\
+			continue;\
+		}\
+		void* bp_element = bplus_tree_element(bp_tree,bp_leaf,bp_i++);\
+		if(bp_hi && !bp_tree->comparison_func(bp_element,bp_hi)) break;\
+		(c);\
+	}\
+})
+
+#endif
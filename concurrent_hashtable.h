@@ -0,0 +1,195 @@
+#ifndef CDS_CONCURRENT_HASHTABLE_H
+#define CDS_CONCURRENT_HASHTABLE_H
+
+// IMPORTANT! THIS HEADER DEPENDS ON "hashtable.h" AND ON PTHREADS (compile with -pthread)!
+
+// We need the hashtable functions
+#include "hashtable.h"
+#include <pthread.h>
+
+// A concurrent hashtable can be used by many threads at the same time, without any other lock
+// It is split into shards, each shard being a hashtable_t with its own read/write lock:
+// - Lookups only take the read lock of one shard, so they never wait for each other
+// - Adding, replacing or removing a pair takes the write lock of one shard
+// - When a shard grows, only the threads using that shard wait for the rehash
+// So with enough shards (a few times the amount of threads), threads rarely wait at all
+// The shard of a pair is picked with its hash, which is only computed once per operation
+// The shards never use incremental rehashing (lookups would have to move hashsets under a read lock)
+
+// Size of a cache line, shards are aligned to it so that two locks never share one
+#ifndef CONCURRENT_HT_CACHE_LINE
+#define CONCURRENT_HT_CACHE_LINE 64
+#endif
+
+// You can overwrite these macros, to allocate the array of shards
+// It must be aligned to CONCURRENT_HT_CACHE_LINE, and its size is always a multiple of it
+#ifndef CONCURRENT_HT_ALLOC
+#include <stdlib.h>
+#define CONCURRENT_HT_ALLOC(sz) aligned_alloc(CONCURRENT_HT_CACHE_LINE,(sz))
+#endif
+
+#ifndef CONCURRENT_HT_FREE
+#include <stdlib.h>
+#define CONCURRENT_HT_FREE(ptr) free((ptr))
+#endif
+
+// A shard of a concurrent hashtable
+// Its alignment makes its size a multiple of a cache line, so each shard starts on its own line
+typedef struct {
+	_Alignas(CONCURRENT_HT_CACHE_LINE) pthread_rwlock_t lock;
+	hashtable_t ht;
+} ht_shard_t;
+
+// The concurrent hashtable structure
+typedef struct {
+	ht_shard_t* shards;
+	size_t shard_count; // Amount of shards, always a power of two
+	size_t (*hashing_func)(size_t,void*); // The hashing function
+	unsigned int max_size; // The max amount of pairs in a single index of a shard (cannot be 0)
+	size_t pair_size; // Size of the key/value pairs, in bytes
+} concurrent_ht_t;
+
+/*
+Creates a concurrent hashtable with nothing in it
+Same arguments as create_ht, the hashing function is used for every shard
+It has to be setup with setup_concurrent_ht before being used (by a single thread)
+*/
+#define create_concurrent_ht(h,m,p) (concurrent_ht_t){NULL,0,(h),(m),(p)}
+
+// Frees a concurrent hashtable
+// No other thread may use it anymore
+#define free_concurrent_ht(h) ({\
+	for(size_t h_s = 0; h_s < (h).shard_count; h_s++){\
+		free_ht((h).shards[h_s].ht);\
+		pthread_rwlock_destroy(&(h).shards[h_s].lock);\
+	}\
+	if((h).shards) CONCURRENT_HT_FREE((h).shards);\
+	(h).shards = NULL;\
+	(h).shard_count = 0;\
+})
+
+// Setup a concurrent hashtable with shard_count shards (rounded up to a power of two)
+// Each shard starts with start_size hashsets, like setup_ht
+void setup_concurrent_ht(concurrent_ht_t* cht, size_t shard_count, int start_size){
+	free_concurrent_ht(*cht);
+	size_t count = 1;
+	while(count < shard_count) count *= 2;
+	cht->shards = CONCURRENT_HT_ALLOC(sizeof(ht_shard_t)*count);
+	memset(cht->shards,0,sizeof(ht_shard_t)*count);
+	cht->shard_count = count;
+	for(size_t i = 0; i < count; i++){
+		pthread_rwlock_init(&cht->shards[i].lock,NULL);
+		cht->shards[i].ht = create_ht(cht->hashing_func,cht->max_size,cht->pair_size);
+		setup_ht(&cht->shards[i].ht,start_size);
+	}
+}
+
+// Get the shard where the pairs with hash x are (as a pointer)
+// The hash is mixed again, since the hashtable of the shard uses its lower bits too
+#define shard_of_concurrent_ht(h,x) (&(h).shards[hash_u64((x)) & ((h).shard_count-1)])
+
+// Add a key/value pair to the concurrent hashtable
+// Like add_ht, this does not check if the key is already in the hashtable (see put_concurrent_ht)
+// When using this function, please pass in a pointer to the key/value pair as the second argument
+void add_concurrent_ht(concurrent_ht_t* cht, void* element_to_add){
+	if(cht->shards == NULL || cht->hashing_func == NULL) return;
+	size_t hash = cht->hashing_func(~(size_t)0,element_to_add);
+	ht_shard_t* shard = shard_of_concurrent_ht(*cht,hash);
+	pthread_rwlock_wrlock(&shard->lock);
+	add_hashed_ht(&shard->ht,element_to_add,hash);
+	pthread_rwlock_unlock(&shard->lock);
+}
+
+// Find a key/value pair in the concurrent hashtable
+// Same arguments as find_ht (the found pair is copied in the fourth one, since it could change right after)
+// Fifth is the index of the element in the hashset it was found in. (is equals to -1 when its not found)
+#define find_concurrent_ht(h,e,c,s,r) ({\
+	typeof((e)) h_find = (e);\
+	size_t h_find_hash = (h).hashing_func(~(size_t)0,&h_find);\
+	ht_shard_t* h_shard = shard_of_concurrent_ht((h),h_find_hash);\
+	(r) = ~0;\
+	pthread_rwlock_rdlock(&h_shard->lock);\
+	hashset_t* hs_find = hashset_of_ht(&h_shard->ht,h_find_hash);\
+	if(hs_find){\
+		find_hs_hashed(*hs_find,h_find,(c),(r),h_find_hash);\
+		if((r) != -1) (s) = *(typeof((s))*) at_sized(*hs_find,(r),(h).pair_size);\
+	}\
+	pthread_rwlock_unlock(&h_shard->lock);\
+})
+
+// Find a key/value pair in the concurrent hashtable, and run code u while its shard is locked for writing
+// In u, the pointer passed as fourth argument points to the pair (or is NULL if its not found)
+// so it can be read and changed, no other thread can use it at the same time
+// Keep u short, every thread using that shard waits for it
+/* EXAMPLE:
+
+struct word_count pair = (struct word_count){"hello"};
+struct word_count* found;
+update_concurrent_ht(cht, pair, !strcmp(h_element.key,h_target.key), found, ({
+	if(found) found->count++;
+}));
+
+*/
+#define update_concurrent_ht(h,e,c,p,u) ({\
+	typeof((e)) h_update = (e);\
+	size_t h_update_hash = (h).hashing_func(~(size_t)0,&h_update), h_index;\
+	ht_shard_t* h_shard = shard_of_concurrent_ht((h),h_update_hash);\
+	pthread_rwlock_wrlock(&h_shard->lock);\
+	hashset_t* hs_update = hashset_of_ht(&h_shard->ht,h_update_hash);\
+	(p) = NULL;\
+	if(hs_update){\
+		find_hs_hashed(*hs_update,h_update,(c),h_index,h_update_hash);\
+		if(h_index != (size_t)~0) (p) = (typeof((p))) at_sized(*hs_update,h_index,(h).pair_size);\
+	}\
+	(u);\
+	pthread_rwlock_unlock(&h_shard->lock);\
+})
+
+// Add a key/value pair to the concurrent hashtable, or replace the pair that has the same key
+// Same arguments as put_ht
+#define put_concurrent_ht(h,e,c) ({\
+	typeof((e)) h_put = (e);\
+	size_t h_put_hash = (h).hashing_func(~(size_t)0,&h_put), h_index;\
+	ht_shard_t* h_shard = shard_of_concurrent_ht((h),h_put_hash);\
+	pthread_rwlock_wrlock(&h_shard->lock);\
+	hashset_t* hs_put = hashset_of_ht(&h_shard->ht,h_put_hash);\
+	if(hs_put){\
+		find_hs_hashed(*hs_put,h_put,(c),h_index,h_put_hash);\
+		if(h_index != (size_t)~0) memcpy(at_sized(*hs_put,h_index,(h).pair_size),&h_put,(h).pair_size);\
+		else add_hashed_ht(&h_shard->ht,&h_put,h_put_hash);\
+	}\
+	pthread_rwlock_unlock(&h_shard->lock);\
+})
+
+// Remove a key/value pair from the concurrent hashtable
+// Same arguments as remove_ht
+#define remove_concurrent_ht(h,e,c,s,r) ({\
+	typeof((e)) h_remove = (e);\
+	size_t h_remove_hash = (h).hashing_func(~(size_t)0,&h_remove);\
+	ht_shard_t* h_shard = shard_of_concurrent_ht((h),h_remove_hash);\
+	(r) = ~0;\
+	pthread_rwlock_wrlock(&h_shard->lock);\
+	hashset_t* hs_remove = hashset_of_ht(&h_shard->ht,h_remove_hash);\
+	if(hs_remove){\
+		find_hs_hashed(*hs_remove,h_remove,(c),(r),h_remove_hash);\
+		if((r) != -1){\
+			(s) = *(typeof((s))*) at_sized(*hs_remove,(r),(h).pair_size);\
+			erase_hs(&h_shard->ht,hs_remove,(r));\
+		}\
+	}\
+	pthread_rwlock_unlock(&h_shard->lock);\
+})
+
+// Parse through all the items of the concurrent hashtable
+// Same as parse_ht, each shard is locked for reading while it is parsed
+// so pairs added or removed by other threads at the same time may or may not be parsed
+// h_s -> size_t, is the index of the current shard (the other variables are the same as parse_ht)
+#define parse_concurrent_ht(h,c) ({\
+	for(size_t h_s = 0; h_s < (h).shard_count; h_s++){\
+		pthread_rwlock_rdlock(&(h).shards[h_s].lock);\
+		parse_ht((h).shards[h_s].ht,(c));\
+		pthread_rwlock_unlock(&(h).shards[h_s].lock);\
+	}\
+})
+
+#endif
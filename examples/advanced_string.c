@@ -5,10 +5,6 @@
 #include "../advanced_string.h"
 
 int main(void){
-	// Set the maxmimum amount of bytes to allocate
-	// everytime we append text to the string
-	_STRING_APPEND = 256;
-
 	// Create an empty string
 	struct String str = create_string();
 	
@@ -28,7 +24,7 @@ int main(void){
 	}
 	
 	// Print the string
-	printf("\n\n====| This is what you just typed: |====\n%s\n",str.str);
+	printf("\n\n====| This is what you just typed: |====\n%s\n",cstr_string(str));
 	
 	// Allocate the memory
 	free_string(str);
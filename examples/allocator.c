@@ -0,0 +1,67 @@
+#include "../allocator.h"
+
+// Every vector and hashtable of this file is allocated from an arena
+#define VECTOR_REALLOC ARENA_REALLOC
+#define VECTOR_FREE ARENA_FREE
+#include "../hashtable.h"
+
+// And every string from a pool
+#define STRING_REALLOC POOL_REALLOC
+#define STRING_FREE POOL_FREE
+#include "../advanced_string.h"
+
+#include <time.h>
+
+#define PAIRS 1000000
+#define STRINGS 100000
+
+typedef struct{
+	uint64_t key;
+	uint64_t value;
+} pair_t;
+
+double seconds_since(clock_t start){
+	return (double)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+int main(void){
+	arena_t arena = create_arena(1 << 20);
+	current_arena = &arena;
+	pool_t pool = create_pool(1 << 16);
+	current_pool = &pool;
+
+	// Fill a hashtable twice in the arena, freeing it with free_ht the first time and by resetting the arena the second time
+	for(int round = 0; round < 2; round++){
+		clock_t start = clock();
+		hashtable_t ht = create_ht(hash_u64_key_ht,16,sizeof(pair_t));
+		setup_ht(&ht,16);
+		for(uint64_t i = 0; i < PAIRS; i++){
+			pair_t pair = {i,i*i};
+			add_ht(&ht,&pair);
+		}
+		printf("Added %d pairs in %.3f s\n",PAIRS,seconds_since(start));
+		start = clock();
+		if(round == 0){
+			free_ht(ht);
+			printf("free_ht took %.6f s\n",seconds_since(start));
+		}
+		else{
+			reset_arena(&arena);
+			printf("reset_arena took %.6f s\n",seconds_since(start));
+		}
+	}
+
+	// A batch of strings in the pool, all freed at once
+	struct String* strings = alloc_arena(&arena,sizeof(struct String)*STRINGS);
+	for(int i = 0; i < STRINGS; i++){
+		strings[i] = create_string();
+		set_string(strings[i],"String #%d",i);
+		append_string(strings[i]," of %d",STRINGS);
+	}
+	printf("%s, %s\n",strings[0].str,strings[STRINGS-1].str);
+	reset_pool(&pool);
+
+	free_pool(&pool);
+	free_arena(&arena);
+	return 0;
+}
@@ -0,0 +1,150 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../linked_list.h"
+#include "../atomic_queue.h"
+
+// Measures the throughput of the queues of atomic_queue.h with producer and consumer threads,
+// and the latency of a SPSC ring (a message sent to another thread and back)
+// Threads that find a queue full or empty yield, so this also runs on a single core (with much lower numbers)
+// Build it with optimizations (cmake -DCMAKE_BUILD_TYPE=Release) to get meaningful numbers
+
+#define ITEMS 2000000
+#define PRODUCERS 4
+#define ROUND_TRIPS 100000
+
+typedef singly_linked_list_with(size_t value) item_t;
+
+double now(void){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC,&t);
+	return t.tv_sec + t.tv_nsec/1e9;
+}
+
+// SPSC ring
+spsc_ring_t ring;
+
+void* spsc_producer(void* arg){
+	for(size_t i = 0; i < ITEMS; i++){
+		while(!push_spsc_ring(&ring,&i)) sched_yield();
+	}
+	return NULL;
+}
+
+// MPSC queue, each producer pushes its own share of the nodes
+mpsc_queue_t mpsc;
+item_t* items;
+
+void* mpsc_producer(void* arg){
+	size_t p = (size_t)arg;
+	for(size_t i = p; i < ITEMS; i += PRODUCERS) push_mpsc_queue(&mpsc,&items[i]);
+	return NULL;
+}
+
+// MPMC queue, with as many consumers as producers
+mpmc_queue_t mpmc;
+atomic_size_t mpmc_popped;
+
+void* mpmc_producer(void* arg){
+	size_t p = (size_t)arg;
+	for(size_t i = p; i < ITEMS; i += PRODUCERS){
+		while(!push_mpmc_queue(&mpmc,&items[i])) sched_yield();
+	}
+	return NULL;
+}
+
+void* mpmc_consumer(void* arg){
+	size_t* sum = arg;
+	while(atomic_load(&mpmc_popped) < ITEMS){
+		item_t* item = pop_mpmc_queue(&mpmc);
+		if(item == NULL){
+			sched_yield();
+			continue;
+		}
+		*sum += item->value;
+		atomic_fetch_add(&mpmc_popped,1);
+	}
+	return NULL;
+}
+
+// Latency: messages go to the echo thread through ping, and come back through pong
+spsc_ring_t ping, pong;
+
+void* echo(void* arg){
+	for(size_t i = 0; i < ROUND_TRIPS; i++){
+		double sent;
+		while(!pop_spsc_ring(&ping,&sent)) sched_yield();
+		while(!push_spsc_ring(&pong,&sent)) sched_yield();
+	}
+	return NULL;
+}
+
+int main(void){
+	pthread_t threads[PRODUCERS*2];
+	size_t expected = (size_t)ITEMS*(ITEMS-1)/2;
+
+	// SPSC
+	create_spsc_ring(&ring,1024,sizeof(size_t));
+	double start = now();
+	pthread_create(&threads[0],NULL,spsc_producer,NULL);
+	size_t sum = 0;
+	for(size_t i = 0; i < ITEMS; i++){
+		size_t value;
+		while(!pop_spsc_ring(&ring,&value)) sched_yield();
+		sum += value;
+	}
+	pthread_join(threads[0],NULL);
+	printf("%-40s %8.2f M items/s%s\n","SPSC ring, 1 producer 1 consumer",ITEMS/(now()-start)/1e6,sum == expected ? "" : " (WRONG SUM)");
+	free_spsc_ring(&ring);
+
+	// MPSC
+	items = malloc(sizeof(item_t)*ITEMS);
+	for(size_t i = 0; i < ITEMS; i++) items[i] = (item_t) create_singly_list_node(i);
+	create_mpsc_queue(&mpsc);
+	start = now();
+	for(size_t p = 0; p < PRODUCERS; p++) pthread_create(&threads[p],NULL,mpsc_producer,(void*)p);
+	sum = 0;
+	for(size_t i = 0; i < ITEMS; i++){
+		item_t* item;
+		while((item = pop_mpsc_queue(&mpsc)) == NULL) sched_yield();
+		sum += item->value;
+	}
+	for(size_t p = 0; p < PRODUCERS; p++) pthread_join(threads[p],NULL);
+	printf("MPSC queue, %d producers 1 consumer %13.2f M items/s%s\n",PRODUCERS,ITEMS/(now()-start)/1e6,sum == expected ? "" : " (WRONG SUM)");
+
+	// MPMC
+	create_mpmc_queue(&mpmc,1024);
+	atomic_init(&mpmc_popped,0);
+	size_t sums[PRODUCERS] = {0};
+	start = now();
+	for(size_t p = 0; p < PRODUCERS; p++){
+		pthread_create(&threads[p],NULL,mpmc_producer,(void*)p);
+		pthread_create(&threads[PRODUCERS+p],NULL,mpmc_consumer,&sums[p]);
+	}
+	for(size_t t = 0; t < PRODUCERS*2; t++) pthread_join(threads[t],NULL);
+	sum = 0;
+	for(size_t p = 0; p < PRODUCERS; p++) sum += sums[p];
+	printf("MPMC queue, %d producers %d consumers %11.2f M items/s%s\n",PRODUCERS,PRODUCERS,ITEMS/(now()-start)/1e6,sum == expected ? "" : " (WRONG SUM)");
+	free_mpmc_queue(&mpmc);
+	free(items);
+
+	// Latency
+	create_spsc_ring(&ping,64,sizeof(double));
+	create_spsc_ring(&pong,64,sizeof(double));
+	pthread_create(&threads[0],NULL,echo,NULL);
+	double total = 0;
+	for(size_t i = 0; i < ROUND_TRIPS; i++){
+		double sent = now(), received;
+		while(!push_spsc_ring(&ping,&sent)) sched_yield();
+		while(!pop_spsc_ring(&pong,&received)) sched_yield();
+		total += now()-received;
+	}
+	pthread_join(threads[0],NULL);
+	printf("%-40s %8.0f ns\n","SPSC ring, average round trip",total/ROUND_TRIPS*1e9);
+	free_spsc_ring(&ping);
+	free_spsc_ring(&pong);
+	return 0;
+}
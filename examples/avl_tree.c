@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../avl_tree.h"
+
+// Adds events sorted by timestamp to a binary tree (binary_tree.h) and to an AVL tree (avl_tree.h)
+// Since the timestamps come in order, the binary tree becomes a linked list, and each insertion walks through all of it
+// Build it with optimizations (cmake -DCMAKE_BUILD_TYPE=Release) to get meaningful numbers
+
+#define BINARY_TREE_EVENTS 10000
+#define AVL_TREE_EVENTS 1000000
+
+typedef binary_tree_with(long timestamp) event_t;
+typedef avl_tree_with(long timestamp) avl_event_t;
+
+// Both node types have the timestamp after their pointers, so they are compared separately
+static _Bool event_after(void* p, void* n){
+	return ((event_t*)n)->timestamp > ((event_t*)p)->timestamp;
+}
+static _Bool avl_event_after(void* p, void* n){
+	return ((avl_event_t*)n)->timestamp > ((avl_event_t*)p)->timestamp;
+}
+
+// Height of a binary tree where every node only has a right child
+static int right_height(event_t* root){
+	int height = 0;
+	for(; root; root = binary_tree_right(root)) height++;
+	return height;
+}
+
+double seconds_since(clock_t start){
+	return (double)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+int main(void){
+	// Binary tree
+	event_t* events = malloc(sizeof(event_t)*BINARY_TREE_EVENTS);
+	clock_t start = clock();
+	for(long t = 0; t < BINARY_TREE_EVENTS; t++){
+		events[t] = (event_t) create_binary_tree_node(t);
+		if(t) add_binary_tree_node(&events[0],&events[t],event_after);
+	}
+	printf("%-12s %8d events in %6.3fs, height %d\n","Binary tree",BINARY_TREE_EVENTS,seconds_since(start),right_height(&events[0]));
+	free(events);
+
+	// AVL tree
+	avl_event_t* avl_events = malloc(sizeof(avl_event_t)*AVL_TREE_EVENTS);
+	avl_event_t* root = NULL;
+	start = clock();
+	for(long t = 0; t < AVL_TREE_EVENTS; t++){
+		avl_events[t] = (avl_event_t) create_avl_tree_node(t);
+		add_avl_tree_node(&root,&avl_events[t],avl_event_after);
+	}
+	printf("%-12s %8d events in %6.3fs, height %d\n","AVL tree",AVL_TREE_EVENTS,seconds_since(start),root->height);
+
+	// Lookups, and walking through a range of events
+	long found = 0;
+	start = clock();
+	for(long t = 0; t < AVL_TREE_EVENTS; t += 7){
+		avl_event_t key = (avl_event_t) create_avl_tree_node(t);
+		found += find_avl_tree_node(root,&key,avl_event_after) != NULL;
+	}
+	printf("%-12s %8ld lookups in %6.3fs\n","AVL tree",found,seconds_since(start));
+
+	avl_event_t key = (avl_event_t) create_avl_tree_node(AVL_TREE_EVENTS/2);
+	long sum = 0;
+	for(avl_event_t* event = lower_bound_avl_tree_node(root,&key,avl_event_after); event && event->timestamp < AVL_TREE_EVENTS/2+100; event = next_avl_tree_node(event)) sum += event->timestamp;
+	printf("Sum of the 100 timestamps from %d: %ld\n",AVL_TREE_EVENTS/2,sum);
+
+	// Remove every other event, the tree stays balanced
+	for(long t = 0; t < AVL_TREE_EVENTS; t += 2) erase_avl_tree_node(&root,&avl_events[t]);
+	printf("Height after removing half of the events: %d\n",root->height);
+	free(avl_events);
+	return 0;
+}
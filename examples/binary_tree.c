@@ -16,17 +16,6 @@ static int print_number_tree(void* node){
 	return printf("%d",((number_tree*)node)->number);
 }
 
-// Find number_tree node in tree
-number_tree* find_number_tree(number_tree* parent, int number){
-	if(parent == NULL) return NULL;
-	if(parent->number == number)
-		return parent;
-	else if(number > parent->number)
-		return find_number_tree(binary_tree_right(parent),number);
-	else
-		return find_number_tree(binary_tree_left(parent),number);
-}
-
 int main(void){
 	number_tree root_node = (number_tree) create_binary_tree_node(50);
 
@@ -48,11 +37,19 @@ int main(void){
 
 	print_binary_tree(&root_node,1,1,print_number_tree);
 
+	// Numbers in [0,60), sorted
+	number_tree lo = (number_tree) create_binary_tree_node(0), hi = (number_tree) create_binary_tree_node(60);
+	parse_binary_tree_range(&root_node,&lo,&hi,compare_number_tree,({
+		printf("%d ",bt_node->number);
+	}));
+	putchar('\n');
+
 	while(1){
 		int number;
 		scanf("%d",&number);
 		getchar();
-		printf("Is %d in the tree? %s\n",number,find_number_tree(&root_node,number)?"true":"false");
+		number_tree key = (number_tree) create_binary_tree_node(number);
+		printf("Is %d in the tree? %s\n",number,find_binary_tree_node(&root_node,&key,compare_number_tree)?"true":"false");
 	}
 
 	free_binary_tree(&root_node);
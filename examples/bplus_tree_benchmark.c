@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BINARY_TREE_FREE_NODE(n) ({ free((n)); })
+
+#define BASIC_VECTOR_TYPES
+#include "../vector.h"
+#include "../binary_tree.h"
+#include "../bplus_tree.h"
+
+// Compares a sorted binary tree (binary_tree.h) with a B+ tree (bplus_tree.h) holding the same numbers
+// The numbers are added in a random order, so the binary tree is not too deep
+// Build it with optimizations (cmake -DCMAKE_BUILD_TYPE=Release) to get meaningful numbers
+
+#define NUMBERS 1000000
+#define LOOKUPS 2000000
+
+typedef binary_tree_with(int number) number_tree_t;
+
+static _Bool number_node_after(void* p, void* n){
+	return ((number_tree_t*)n)->number > ((number_tree_t*)p)->number;
+}
+
+static _Bool number_after(void* p, void* n){
+	return *(int*)n > *(int*)p;
+}
+
+double seconds_since(clock_t start){
+	return (double)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+size_t random_index(size_t n){
+	return ((size_t)rand()*RAND_MAX+rand()) % n;
+}
+
+int main(void){
+	srand(42);
+
+	// Even numbers in a random order, so half of the lookups find nothing
+	struct int_vector numbers = (struct int_vector) create_vector();
+	numbers.arr = malloc(sizeof(int)*NUMBERS);
+	numbers.size = NUMBERS;
+	for(size_t i = 0; i < NUMBERS; i++) numbers.arr[i] = 2*i;
+	for(size_t i = NUMBERS-1; i > 0; i--){
+		size_t j = random_index(i+1);
+		int tmp = numbers.arr[i];
+		numbers.arr[i] = numbers.arr[j];
+		numbers.arr[j] = tmp;
+	}
+	int* keys = malloc(sizeof(int)*LOOKUPS);
+	for(size_t i = 0; i < LOOKUPS; i++) keys[i] = random_index(2*NUMBERS);
+
+	// Building
+	number_tree_t* root = NULL;
+	clock_t start = clock();
+	for(size_t i = 0; i < NUMBERS; i++){
+		number_tree_t* node = malloc(sizeof(number_tree_t));
+		*node = (number_tree_t) create_binary_tree_node(numbers.arr[i]);
+		if(root) add_binary_tree_node(root,node,number_node_after);
+		else root = node;
+	}
+	printf("%-26s %8.2f M numbers/s\n","Binary tree inserts",NUMBERS/seconds_since(start)/1e6);
+
+	bplus_tree_t tree = create_bplus_tree(int,number_after);
+	start = clock();
+	for(size_t i = 0; i < NUMBERS; i++) add_bplus_tree(&tree,&numbers.arr[i]);
+	printf("%-26s %8.2f M numbers/s (height %u)\n","B+ tree inserts",NUMBERS/seconds_since(start)/1e6,tree.height);
+
+	radix_sort_int_vector(&numbers);
+	bplus_tree_t built = create_bplus_tree(int,number_after);
+	start = clock();
+	build_vector_bplus_tree(&built,numbers);
+	printf("%-26s %8.2f M numbers/s (height %u)\n","B+ tree bulk load",NUMBERS/seconds_since(start)/1e6,built.height);
+
+	// Lookups
+	long found = 0;
+	start = clock();
+	for(size_t i = 0; i < LOOKUPS; i++){
+		number_tree_t key = (number_tree_t) create_binary_tree_node(keys[i]);
+		found += find_binary_tree_node(root,&key,number_node_after) != NULL;
+	}
+	printf("%-26s %8.2f M lookups/s (%ld found)\n","Binary tree lookups",LOOKUPS/seconds_since(start)/1e6,found);
+
+	found = 0;
+	start = clock();
+	for(size_t i = 0; i < LOOKUPS; i++) found += find_bplus_tree(&tree,&keys[i]) != NULL;
+	printf("%-26s %8.2f M lookups/s (%ld found)\n","B+ tree lookups",LOOKUPS/seconds_since(start)/1e6,found);
+
+	// Walking through every number, in order
+	long long sum = 0;
+	start = clock();
+	parse_binary_tree_in_order(root,({ sum += bt_node->number; }));
+	printf("%-26s %8.2f M numbers/s (sum %lld)\n","Binary tree scan",NUMBERS/seconds_since(start)/1e6,sum);
+
+	sum = 0;
+	start = clock();
+	parse_bplus_tree(&tree,NULL,NULL,({ sum += *(int*)bp_element; }));
+	printf("%-26s %8.2f M numbers/s (sum %lld)\n","B+ tree scan",NUMBERS/seconds_since(start)/1e6,sum);
+
+	// Removing everything
+	start = clock();
+	for(size_t i = 0; i < NUMBERS; i++) remove_bplus_tree(&built,&numbers.arr[i]);
+	printf("%-26s %8.2f M numbers/s (%zu left)\n","B+ tree removals",NUMBERS/seconds_since(start)/1e6,built.size);
+
+	free(keys);
+	free_vector(numbers);
+	free_binary_tree(root);
+	free_bplus_tree(&tree);
+	free_bplus_tree(&built);
+	return 0;
+}
@@ -0,0 +1,110 @@
+#include "../concurrent_hashtable.h"
+#include <stdlib.h>
+#include <time.h>
+
+// Compares a hashtable_t behind a single mutex with a concurrent_ht_t (sharded, one read/write lock per shard)
+// Every thread does 90% lookups and 10% puts on random integer keys
+// Build it with optimizations (cmake -DCMAKE_BUILD_TYPE=Release) to get meaningful numbers
+// The sharded hashtable only pulls ahead when the threads actually run in parallel (more than one core)
+
+#define PAIRS 200000
+#define OPERATIONS 2000000 // Per thread count, split between the threads
+#define MAX_THREADS 16
+#define SHARDS 64
+
+typedef struct{
+	uint64_t key;
+	uint64_t value;
+} pair_t;
+
+hashtable_t global_ht;
+pthread_mutex_t global_lock = PTHREAD_MUTEX_INITIALIZER;
+concurrent_ht_t cht;
+
+typedef struct{
+	pthread_t thread;
+	unsigned int seed;
+	size_t operations;
+	size_t found;
+} worker_t;
+
+// Small xorshift generator, rand() takes a lock in some libcs
+uint32_t next_random(unsigned int* seed){
+	*seed ^= *seed << 13;
+	*seed ^= *seed >> 17;
+	*seed ^= *seed << 5;
+	return *seed;
+}
+
+void* global_worker(void* arg){
+	worker_t* w = arg;
+	for(size_t i = 0; i < w->operations; i++){
+		uint32_t r = next_random(&w->seed);
+		pair_t pair = {r % (PAIRS*2), i}, result;
+		size_t index;
+		pthread_mutex_lock(&global_lock);
+		if(r % 10 == 0) put_ht(global_ht,pair,h_element.key == h_target.key);
+		else{
+			find_ht(global_ht,pair,h_element.key == h_target.key,result,index);
+			w->found += index != -1;
+		}
+		pthread_mutex_unlock(&global_lock);
+	}
+	return NULL;
+}
+
+void* concurrent_worker(void* arg){
+	worker_t* w = arg;
+	for(size_t i = 0; i < w->operations; i++){
+		uint32_t r = next_random(&w->seed);
+		pair_t pair = {r % (PAIRS*2), i}, result;
+		size_t index;
+		if(r % 10 == 0) put_concurrent_ht(cht,pair,h_element.key == h_target.key);
+		else{
+			find_concurrent_ht(cht,pair,h_element.key == h_target.key,result,index);
+			w->found += index != -1;
+		}
+	}
+	return NULL;
+}
+
+double now(void){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC,&t);
+	return t.tv_sec + t.tv_nsec/1e9;
+}
+
+// Run the worker function f with n threads, and return the amount of operations per second
+double run(void* (*f)(void*), int n){
+	worker_t workers[MAX_THREADS];
+	double start = now();
+	for(int t = 0; t < n; t++){
+		workers[t] = (worker_t){0,(unsigned int)t*7919+1,OPERATIONS/n,0};
+		pthread_create(&workers[t].thread,NULL,f,&workers[t]);
+	}
+	for(int t = 0; t < n; t++) pthread_join(workers[t].thread,NULL);
+	return (OPERATIONS/n)*n/(now()-start);
+}
+
+int main(void){
+	global_ht = create_ht(hash_u64_key_ht,16,sizeof(pair_t));
+	setup_ht(&global_ht,1024);
+	cht = create_concurrent_ht(hash_u64_key_ht,16,sizeof(pair_t));
+	setup_concurrent_ht(&cht,SHARDS,64);
+	for(uint64_t i = 0; i < PAIRS; i++){
+		pair_t pair = {i*2,i};
+		add_ht(&global_ht,&pair);
+		add_concurrent_ht(&cht,&pair);
+	}
+
+	printf("%-8s %22s %22s\n","threads","hashtable_t + mutex","concurrent_ht_t");
+	for(int n = 1; n <= MAX_THREADS; n *= 2){
+		double global_ops = run(global_worker,n);
+		double concurrent_ops = run(concurrent_worker,n);
+		printf("%-8d %17.2f M/s %17.2f M/s\n",n,global_ops/1e6,concurrent_ops/1e6);
+	}
+
+	free_ht(global_ht);
+	free_concurrent_ht(cht);
+	return 0;
+}
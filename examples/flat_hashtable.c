@@ -0,0 +1,54 @@
+#include "../flat_hashtable.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct{
+	char* key; // A word
+	unsigned int count; // How many times it was typed
+} word_pair_t;
+
+// My hashing function
+size_t hashfunc(size_t ht_size, void* element){
+	word_pair_t pair = * (word_pair_t*) element;
+	size_t index = 5381;
+	for(char* c = pair.key; *c; c++){
+		index = index*33 + (size_t)*c;
+	}
+	return index % ht_size; // The flat hashtable gives ~0 as the size, so this is the whole hash
+}
+
+int main(void){
+	// Create a flat hashtable, no memory is allocated before the first word
+	flat_hashtable_t ht = create_flat_ht(hashfunc,sizeof(word_pair_t));
+
+	printf("Type words, one per line, enter quit to stop!\n");
+	while(1){
+		char word[50];
+		if(!fgets(word,49,stdin)) break;
+		word[strcspn(word,"\n")] = '\0';
+		if(!strcmp(word,"quit")) break;
+
+		// Look for the word, the slot is -1 if it's not in the hashtable
+		word_pair_t pair = (word_pair_t){word,1};
+		size_t slot = probe_flat_ht(ht,pair,!strcmp(h_element.key,h_target.key));
+		if(slot != -1){
+			// The pairs stay in place, so we can change them through a pointer
+			word_pair_t* found = (word_pair_t*) at_flat_ht(ht,slot);
+			found->count++;
+		}else{
+			// Allocate the key, the pair is copied in the hashtable
+			pair.key = strcpy(malloc(strlen(word)+1),word);
+			add_flat_ht(&ht,&pair);
+		}
+	}
+
+	printf("%lu different words (%lu slots):\n",ht.size,ht.capacity);
+	parse_flat_ht(ht,({
+		word_pair_t* pair = (word_pair_t*) h_element;
+		printf("- %s : %u\n",pair->key,pair->count);
+		free(pair->key);
+	}));
+	free_flat_ht(ht);
+
+	return 0;
+}
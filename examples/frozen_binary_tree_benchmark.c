@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BINARY_TREE_FREE_NODE(n) ({ free((n)); })
+
+#include "../frozen_binary_tree.h"
+
+// Compares lookups in a sorted binary tree (binary_tree.h) with lookups in the same tree, frozen (frozen_binary_tree.h)
+// The nodes are added in a random order, so the tree is not too deep, but they are spread in memory
+// Build it with optimizations (cmake -DCMAKE_BUILD_TYPE=Release) to get meaningful numbers
+
+#define NODES 1000000
+#define LOOKUPS 2000000
+
+typedef binary_tree_with(int number) number_tree_t;
+
+static _Bool number_after(void* p, void* n){
+	return ((number_tree_t*)n)->number > ((number_tree_t*)p)->number;
+}
+
+double seconds_since(clock_t start){
+	return (double)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+int random_number(void){
+	return (int)(((unsigned)rand()*RAND_MAX+rand()) % (2*NODES));
+}
+
+int main(void){
+	srand(42);
+
+	number_tree_t* root = NULL;
+	for(int i = 0; i < NODES; i++){
+		number_tree_t* node = malloc(sizeof(number_tree_t));
+		*node = (number_tree_t) create_binary_tree_node(random_number());
+		if(root) add_binary_tree_node(root,node,number_after);
+		else root = node;
+	}
+
+	clock_t start = clock();
+	frozen_binary_tree_t frozen = freeze_binary_tree(root);
+	printf("Froze %u nodes in %.3fs\n",frozen.count,seconds_since(start));
+
+	int* keys = malloc(sizeof(int)*LOOKUPS);
+	for(int i = 0; i < LOOKUPS; i++) keys[i] = random_number();
+
+	long found = 0;
+	start = clock();
+	for(int i = 0; i < LOOKUPS; i++){
+		number_tree_t key = (number_tree_t) create_binary_tree_node(keys[i]);
+		found += find_binary_tree_node(root,&key,number_after) != NULL;
+	}
+	printf("%-20s %8.2f M lookups/s (%ld found)\n","Binary tree",LOOKUPS/seconds_since(start)/1e6,found);
+
+	found = 0;
+	start = clock();
+	for(int i = 0; i < LOOKUPS; i++){
+		number_tree_t key = (number_tree_t) create_binary_tree_node(keys[i]);
+		found += find_frozen_binary_tree(&frozen,&key,number_after) != NULL;
+	}
+	printf("%-20s %8.2f M lookups/s (%ld found)\n","Frozen binary tree",LOOKUPS/seconds_since(start)/1e6,found);
+
+	free(keys);
+	free_frozen_binary_tree(&frozen);
+	free_binary_tree(root);
+	return 0;
+}
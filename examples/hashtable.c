@@ -16,24 +16,15 @@ typedef struct{
 	size_t size;
 } person_vector_t;
 
-// My hashing function
-size_t hashfunc(size_t ht_size, void* element){
-	person_pair_t pair = * (person_pair_t*) element;
-	size_t index = 0;
-	for(int i = 0; i < strlen(pair.key); i++){
-		index += (size_t)pair.key[i];
-	}
-	return index % ht_size;
-}
-
 int main(void){
-	// Create a hashtable with a maximum of 16 elements per index and 5 starting indices
+	// Create a hashtable with a maximum of 16 elements per index and 8 starting indices
+	// The key of the pairs is a char*, so we can use the built-in string key hashing function
 	hashtable_t ht = create_ht(
-		hashfunc,
+		hash_string_key_ht,
 		16,
 		sizeof(person_pair_t)
 	);
-	setup_ht(&ht,5);
+	setup_ht(&ht,8);
 
 	// Get input from the user
 	// Asks them to input people
@@ -53,11 +44,11 @@ int main(void){
 		getchar(); // Skip the endline character left by scanf()
 		// Allocate the key (name) of the person and create the pair
 		person_pair_t new_person = (person_pair_t){
-			malloc(strlen(name)),
+			malloc(strlen(name)+1),
 			age
 		};
 		// Copy the temporary buffer's data into the pair's key
-		memcpy(new_person.key,name,strlen(name));
+		strcpy(new_person.key,name);
 		// Add the pair to the hashtable
 		add_ht(&ht,&new_person);
 		printf("Added person:\n%s -> %u years old.\n",new_person.key,new_person.age);
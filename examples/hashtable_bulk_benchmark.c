@@ -0,0 +1,65 @@
+#include "../hashtable.h"
+#include <stdlib.h>
+#include <time.h>
+
+// Compares building a hashtable_t with add_ht and with build_ht,
+// then looking keys up one at a time with find_ht and in batches with find_many_ht
+// Build it with optimizations (cmake -DCMAKE_BUILD_TYPE=Release) to get meaningful numbers
+
+#define PAIRS 4000000
+#define LOOKUPS 4000000
+
+typedef struct{
+	uint64_t key;
+	uint64_t value;
+} pair_t;
+
+double seconds_since(clock_t start){
+	return (double)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+int main(void){
+	pair_t* pairs = malloc(sizeof(pair_t)*PAIRS);
+	for(size_t i = 0; i < PAIRS; i++) pairs[i] = (pair_t){i*2,i};
+
+	// Building
+	hashtable_t added = create_ht(hash_u64_key_ht,16,sizeof(pair_t));
+	setup_ht(&added,16);
+	clock_t start = clock();
+	for(size_t i = 0; i < PAIRS; i++) add_ht(&added,&pairs[i]);
+	printf("%-24s %8.3f s\n","add_ht (one by one)",seconds_since(start));
+
+	hashtable_t built = create_ht(hash_u64_key_ht,16,sizeof(pair_t));
+	start = clock();
+	build_ht(&built,pairs,PAIRS);
+	printf("%-24s %8.3f s\n","build_ht",seconds_since(start));
+
+	// Lookups, half of the keys are in the hashtable
+	pair_t* keys = malloc(sizeof(pair_t)*LOOKUPS);
+	pair_t* results = malloc(sizeof(pair_t)*LOOKUPS);
+	size_t* indexes = malloc(sizeof(size_t)*LOOKUPS);
+	srand(42);
+	for(size_t l = 0; l < LOOKUPS; l++) keys[l] = (pair_t){((size_t)rand()*RAND_MAX+rand()) % (PAIRS*2)};
+
+	size_t found = 0;
+	start = clock();
+	for(size_t l = 0; l < LOOKUPS; l++){
+		find_ht(built,keys[l],h_element.key == h_target.key,results[l],indexes[l]);
+		found += indexes[l] != -1;
+	}
+	printf("%-24s %8.2f M lookups/s (%zu found)\n","find_ht",LOOKUPS/seconds_since(start)/1e6,found);
+
+	found = 0;
+	start = clock();
+	find_many_ht(built,keys,LOOKUPS,h_element.key == h_target.key,results,indexes);
+	for(size_t l = 0; l < LOOKUPS; l++) found += indexes[l] != -1;
+	printf("%-24s %8.2f M lookups/s (%zu found)\n","find_many_ht",LOOKUPS/seconds_since(start)/1e6,found);
+
+	free_ht(added);
+	free_ht(built);
+	free(pairs);
+	free(keys);
+	free(results);
+	free(indexes);
+	return 0;
+}
@@ -0,0 +1,116 @@
+#include "../flat_hashtable.h"
+#include <stdlib.h>
+#include <time.h>
+
+// Compares lookups in hashtable_t (scanning hashset vectors) and flat_hashtable_t (probing control bytes)
+// with integer keys and short string keys
+// Build it with optimizations (cmake -DCMAKE_BUILD_TYPE=Release) to get meaningful numbers
+// Add -mavx2 (or -march=native) to use AVX2, or -DHASHTABLE_NO_SIMD to compare with the portable code
+
+#define PAIRS 1000000
+#define LOOKUPS 4000000
+
+typedef struct{
+	size_t key;
+	size_t value;
+} int_pair_t;
+
+typedef struct{
+	char key[16];
+	size_t value;
+} string_pair_t;
+
+size_t int_hashfunc(size_t ht_size, void* element){
+	size_t x = ((int_pair_t*)element)->key;
+	x ^= x >> 31;
+	x *= 0x9E3779B97F4A7C15ULL;
+	return (x ^ (x >> 29)) % ht_size;
+}
+
+size_t string_hashfunc(size_t ht_size, void* element){
+	size_t index = 14695981039346656037ULL;
+	for(char* c = ((string_pair_t*)element)->key; *c; c++){
+		index = (index ^ (unsigned char)*c) * 1099511628211ULL;
+	}
+	return index % ht_size;
+}
+
+// Time the lookups of statement s, run LOOKUPS times with the index l
+#define bench_lookups(name, s) ({\
+	size_t found = 0;\
+	clock_t start = clock();\
+	for(size_t l = 0; l < LOOKUPS; l++){\
+		s;\
+	}\
+	double seconds = (double)(clock()-start)/CLOCKS_PER_SEC;\
+	printf("%-34s %8.2f M probes/s (%zu found)\n",(name),LOOKUPS/seconds/1e6,found);\
+})
+
+int main(void){
+	printf("SIMD: %s\n\n",HASHTABLE_SIMD ? (
+#ifdef __AVX2__
+		"AVX2 + SSE2"
+#else
+		"SSE2"
+#endif
+	) : "none (portable code)");
+
+	// Keys to look for, half of them are in the hashtables
+	size_t* keys = malloc(sizeof(size_t)*LOOKUPS);
+	srand(42);
+	for(size_t l = 0; l < LOOKUPS; l++) keys[l] = ((size_t)rand()*RAND_MAX+rand()) % (PAIRS*2);
+
+	// Integer keys
+	hashtable_t ht = create_ht(int_hashfunc,16,sizeof(int_pair_t));
+	setup_ht(&ht,1024);
+	flat_hashtable_t flat = create_flat_ht(int_hashfunc,sizeof(int_pair_t));
+	for(size_t i = 0; i < PAIRS; i++){
+		int_pair_t pair = {i,i};
+		add_ht(&ht,&pair);
+		add_flat_ht(&flat,&pair);
+	}
+	bench_lookups("hashtable_t, int keys",({
+		int_pair_t pair = {keys[l]}, result;
+		size_t index;
+		find_ht(ht,pair,h_element.key == h_target.key,result,index);
+		found += index != -1;
+	}));
+	bench_lookups("flat_hashtable_t, int keys",({
+		int_pair_t pair = {keys[l]}, result;
+		size_t slot;
+		find_flat_ht(flat,pair,h_element.key == h_target.key,result,slot);
+		found += slot != -1;
+	}));
+	free_ht(ht);
+	free_flat_ht(flat);
+
+	// Short string keys
+	ht = create_ht(string_hashfunc,16,sizeof(string_pair_t));
+	setup_ht(&ht,1024);
+	flat = create_flat_ht(string_hashfunc,sizeof(string_pair_t));
+	for(size_t i = 0; i < PAIRS; i++){
+		string_pair_t pair = {"",i};
+		snprintf(pair.key,16,"key%zu",i);
+		add_ht(&ht,&pair);
+		add_flat_ht(&flat,&pair);
+	}
+	bench_lookups("hashtable_t, string keys",({
+		string_pair_t pair;
+		size_t index;
+		snprintf(pair.key,16,"key%zu",keys[l]);
+		find_ht(ht,pair,!strcmp(h_element.key,h_target.key),pair,index);
+		found += index != -1;
+	}));
+	bench_lookups("flat_hashtable_t, string keys",({
+		string_pair_t pair;
+		size_t slot;
+		snprintf(pair.key,16,"key%zu",keys[l]);
+		find_flat_ht(flat,pair,!strcmp(h_element.key,h_target.key),pair,slot);
+		found += slot != -1;
+	}));
+	free_ht(ht);
+	free_flat_ht(flat);
+
+	free(keys);
+	return 0;
+}
@@ -0,0 +1,60 @@
+#include "../mapped_hashtable.h"
+#include <time.h>
+
+// Saves a hashtable of 1 million people in a file, then maps it back and looks people up in it
+// Opening the mapped hashtable takes no time, compared to building the hashtable again
+
+#define PEOPLE 1000000
+
+typedef struct{
+	char key[24]; // Name
+	unsigned int age;
+} person_pair_t;
+
+double seconds_since(clock_t start){
+	return (double)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+int main(void){
+	const char* path = "people.ht";
+	person_pair_t* people = malloc(sizeof(person_pair_t)*PEOPLE);
+	for(size_t i = 0; i < PEOPLE; i++){
+		people[i] = (person_pair_t){"",(unsigned int)(i % 100)};
+		snprintf(people[i].key,sizeof(people[i].key),"person%zu",i);
+	}
+
+	// Build the hashtable and save it
+	clock_t start = clock();
+	hashtable_t ht = create_ht(hash_char_array_key_ht,16,sizeof(person_pair_t));
+	build_ht(&ht,people,PEOPLE);
+	printf("Built the hashtable in %.3f s\n",seconds_since(start));
+	if(save_ht(&ht,path) == -1){
+		printf("Failed to save the hashtable!\n");
+		return 1;
+	}
+	free_ht(ht);
+	free(people);
+
+	// Map it back, which is what another process (or the same one after a restart) would do
+	start = clock();
+	mapped_ht_t mapped;
+	if(open_mapped_ht(&mapped,path,hash_char_array_key_ht,person_pair_t) == -1){
+		printf("Failed to open the hashtable!\n");
+		return 1;
+	}
+	printf("Opened the mapped hashtable (%zu people) in %.6f s\n",mapped.count,seconds_since(start));
+
+	const char* names[] = {"person42","person999999","nobody"};
+	for(int i = 0; i < 3; i++){
+		person_pair_t person = (person_pair_t){""}, found_person;
+		strcpy(person.key,names[i]);
+		size_t result;
+		find_mapped_ht(mapped,person,!strcmp(h_element.key,h_target.key),found_person,result);
+		if(result == -1) printf("%s not found!\n",names[i]);
+		else printf("%s is %u years old\n",found_person.key,found_person.age);
+	}
+
+	close_mapped_ht(&mapped);
+	remove(path);
+	return 0;
+}
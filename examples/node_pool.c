@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../node_pool.h"
+
+// Removed nodes go back to the current node pool
+#define LINKED_LIST_FREE_NODE(n) NODE_POOL_FREE_NODE((n))
+#define BINARY_TREE_FREE_NODE(n) NODE_POOL_FREE_NODE((n))
+#include "../linked_list.h"
+#include "../binary_tree.h"
+
+// Builds a linked list and a binary tree of NODES nodes, with malloc and with node pools,
+// then frees them by walking through them, or by resetting the pools
+
+#define NODES 1000000
+
+typedef singly_linked_list_with(int number) number_list_t;
+typedef binary_tree_with(int number) number_tree_t;
+
+_Bool check_bigger(void* p, void* n){
+	return ((number_tree_t*)n)->number > ((number_tree_t*)p)->number;
+}
+
+double seconds_since(clock_t start){
+	return (double)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+int main(void){
+	// With malloc
+	clock_t start = clock();
+	number_list_t* list = NULL;
+	for(int i = 0; i < NODES; i++){
+		number_list_t* node = malloc(sizeof(number_list_t));
+		*node = (number_list_t) create_singly_list_node(i);
+		node->next = list;
+		list = node;
+	}
+	printf("%-36s %8.3f s\n","List of malloc'd nodes, created in",seconds_since(start));
+	start = clock();
+	while(list){
+		number_list_t* next = linked_list_next(list);
+		free(list);
+		list = next;
+	}
+	printf("%-36s %8.3f s\n","List of malloc'd nodes, freed in",seconds_since(start));
+
+	// With a node pool
+	node_pool_t list_pool = create_node_pool(number_list_t);
+	current_node_pool = &list_pool;
+	start = clock();
+	list = new_singly_list_node(&list_pool,number_list_t,0);
+	for(int i = 1; i < NODES; i++){
+		number_list_t* node = new_singly_list_node(&list_pool,number_list_t,i);
+		node->next = list;
+		list = node;
+	}
+	printf("%-36s %8.3f s\n","List of pooled nodes, created in",seconds_since(start));
+	// Single nodes can still be removed, they go back to the pool
+	linked_list_remove_next(list);
+	start = clock();
+	reset_node_pool(&list_pool);
+	printf("%-36s %8.6f s\n","List of pooled nodes, freed in",seconds_since(start));
+
+	// A binary tree in its own pool (with random numbers, so it stays balanced enough to be added to recursively)
+	node_pool_t tree_pool = create_node_pool(number_tree_t);
+	current_node_pool = &tree_pool;
+	srand(42);
+	start = clock();
+	number_tree_t* root = new_binary_tree_node(&tree_pool,number_tree_t,rand());
+	for(int i = 1; i < NODES; i++){
+		add_binary_tree_node(root,new_binary_tree_node(&tree_pool,number_tree_t,rand()),check_bigger);
+	}
+	printf("%-36s %8.3f s\n","Tree of pooled nodes, created in",seconds_since(start));
+	start = clock();
+	free_binary_tree(root); // Gives every node back to the pool one by one
+	printf("%-36s %8.3f s (%zu nodes left)\n","Tree freed node by node in",seconds_since(start),tree_pool.count);
+
+	free_node_pool(&list_pool);
+	free_node_pool(&tree_pool);
+	return 0;
+}
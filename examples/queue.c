@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define LINKED_LIST_FREE_NODE(n) ({ free((n)); })
+
+#include "../queue.h"
+
+// Uses a queue as a FIFO of pending jobs,
+// and compares building a list with linked_list_add_end and with push_back_singly_queue
+
+#define JOBS 20000
+
+typedef singly_linked_list_with(int id) job_t;
+typedef queue_of(job_t) job_queue_t;
+
+job_t* new_job(int id){
+	job_t* job = malloc(sizeof(job_t));
+	*job = (job_t) create_singly_list_node(id);
+	return job;
+}
+
+double seconds_since(clock_t start){
+	return (double)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+int main(void){
+	// A few jobs, run in the order they were added
+	job_queue_t jobs = create_queue();
+	for(int i = 0; i < 5; i++) push_back_singly_queue(jobs,new_job(i));
+	push_front_singly_queue(jobs,new_job(-1)); // An urgent one
+	printf("%zu jobs pending\n",jobs.count);
+
+	job_t* job;
+	while((job = pop_front_singly_queue(jobs))){
+		printf("Running job %d\n",job->id);
+		// Running a job can add other jobs
+		if(job->id == 2){
+			job_queue_t more_jobs = create_queue();
+			push_back_singly_queue(more_jobs,new_job(20));
+			push_back_singly_queue(more_jobs,new_job(21));
+			concat_singly_queue(jobs,more_jobs);
+		}
+		free(job);
+	}
+
+	// Building a list of JOBS nodes
+	clock_t start = clock();
+	job_t* first = new_job(0);
+	for(int i = 1; i < JOBS; i++) linked_list_add_end(first,new_job(i));
+	printf("%-32s %8.3f s\n","linked_list_add_end",seconds_since(start));
+	free_singly_linked_list(first);
+
+	start = clock();
+	for(int i = 0; i < JOBS; i++) push_back_singly_queue(jobs,new_job(i));
+	printf("%-32s %8.3f s\n","push_back_singly_queue",seconds_since(start));
+	free_queue(jobs);
+
+	return 0;
+}
@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Count the allocations made by the strings
+size_t string_allocations = 0;
+#define STRING_REALLOC(ptr, sz) (string_allocations += (ptr) == NULL, realloc((ptr),(sz)))
+
+#include "../advanced_string.h"
+
+// Compares struct String and struct SmallString holding many short identifiers (and a few longer ones)
+// Build it with optimizations (cmake -DCMAKE_BUILD_TYPE=Release) to get meaningful numbers
+
+#define STRINGS 1000000
+
+double seconds_since(clock_t start){
+	return (double)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+int main(void){
+	struct String* strings = malloc(sizeof(struct String)*STRINGS);
+	struct SmallString* small_strings = malloc(sizeof(struct SmallString)*STRINGS);
+	size_t characters = 0;
+
+	// One string in 100 is longer than a small string can hold
+	clock_t start = clock();
+	for(int i = 0; i < STRINGS; i++){
+		strings[i] = create_string();
+		set_string(strings[i],"user_%d",i);
+		if(i % 100 == 0) append_string(strings[i],"@some.long.domain.name");
+	}
+	for(int i = 0; i < STRINGS; i++) characters += length_string(strings[i]);
+	for(int i = 0; i < STRINGS; i++) free_string(strings[i]);
+	printf("%-14s %6.3fs, %zu allocations (%zu characters)\n","String",seconds_since(start),string_allocations,characters);
+
+	string_allocations = 0;
+	characters = 0;
+	start = clock();
+	for(int i = 0; i < STRINGS; i++){
+		small_strings[i] = create_small_string();
+		set_string(small_strings[i],"user_%d",i);
+		if(i % 100 == 0) append_string(small_strings[i],"@some.long.domain.name");
+	}
+	for(int i = 0; i < STRINGS; i++) characters += length_string(small_strings[i]);
+	for(int i = 0; i < STRINGS; i++) free_string(small_strings[i]);
+	printf("%-14s %6.3fs, %zu allocations (%zu characters)\n","SmallString",seconds_since(start),string_allocations,characters);
+
+	free(strings);
+	free(small_strings);
+	return 0;
+}
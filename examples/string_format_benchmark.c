@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../advanced_string.h"
+
+// Compares writing numbers in a string with append_string (printf formats) and with the number appenders
+// Build it with optimizations (cmake -DCMAKE_BUILD_TYPE=Release) to get meaningful numbers
+
+#define NUMBERS 2000000
+
+double seconds_since(clock_t start){
+	return (double)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+int main(void){
+	srand(42);
+	long long* integers = malloc(sizeof(long long)*NUMBERS);
+	double* floats = malloc(sizeof(double)*NUMBERS);
+	for(int i = 0; i < NUMBERS; i++){
+		integers[i] = (long long)rand()*rand()-RAND_MAX;
+		floats[i] = (rand()-RAND_MAX/2)/1000.0;
+	}
+
+	struct String line = create_string();
+
+	clock_t start = clock();
+	for(int i = 0; i < NUMBERS; i++) append_string(line,"%lld,",integers[i]);
+	printf("%-28s %8.2f M numbers/s (%zu chars)\n","append_string(\"%lld\")",NUMBERS/seconds_since(start)/1e6,line.size);
+
+	line.size = 0;
+	start = clock();
+	for(int i = 0; i < NUMBERS; i++){
+		append_int_string(&line,integers[i]);
+		append_char_string(line,',');
+	}
+	printf("%-28s %8.2f M numbers/s (%zu chars)\n","append_int_string",NUMBERS/seconds_since(start)/1e6,line.size);
+
+	line.size = 0;
+	start = clock();
+	for(int i = 0; i < NUMBERS; i++) append_string(line,"%.3f,",floats[i]);
+	printf("%-28s %8.2f M numbers/s (%zu chars)\n","append_string(\"%.3f\")",NUMBERS/seconds_since(start)/1e6,line.size);
+
+	line.size = 0;
+	start = clock();
+	for(int i = 0; i < NUMBERS; i++){
+		append_float_string(&line,floats[i],3);
+		append_char_string(line,',');
+	}
+	printf("%-28s %8.2f M numbers/s (%zu chars)\n","append_float_string",NUMBERS/seconds_since(start)/1e6,line.size);
+
+	free_string(line);
+	free(integers);
+	free(floats);
+	return 0;
+}
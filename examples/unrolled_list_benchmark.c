@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define LINKED_LIST_FREE_NODE(n) ({ free((n)); })
+
+#include "../linked_list.h"
+#include "../unrolled_list.h"
+
+// Compares a linked list with one element per node (linked_list.h) and an unrolled list (unrolled_list.h)
+// The nodes of the linked list are linked in a random order, like they end up after many inserts and removals
+// Build it with optimizations (cmake -DCMAKE_BUILD_TYPE=Release) to get meaningful numbers
+
+#define ELEMENTS 200000
+#define PASSES 10
+#define INSERTS 200
+
+typedef singly_linked_list_with(int number) number_list_t;
+typedef unrolled_list_of(int) int_list_t;
+
+double seconds_since(clock_t start){
+	return (double)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+int main(void){
+	srand(42);
+
+	// Node per element, allocated in one go and linked in a random order
+	number_list_t* nodes = malloc(sizeof(number_list_t)*ELEMENTS);
+	size_t* order = malloc(sizeof(size_t)*ELEMENTS);
+	for(size_t i = 0; i < ELEMENTS; i++) order[i] = i;
+	for(size_t i = ELEMENTS-1; i > 0; i--){
+		size_t j = ((size_t)rand()*RAND_MAX+rand()) % (i+1), tmp = order[i];
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+	for(size_t i = 0; i < ELEMENTS; i++){
+		nodes[order[i]] = (number_list_t) create_singly_list_node((int)i);
+		if(i) nodes[order[i-1]].next = &nodes[order[i]];
+	}
+	number_list_t* first = &nodes[order[0]];
+
+	int_list_t list = create_unrolled_list();
+	for(int i = 0; i < ELEMENTS; i++) push_back_unrolled_list(list,i);
+
+	// Iteration
+	long long sum = 0;
+	clock_t start = clock();
+	for(int p = 0; p < PASSES; p++){
+		for(number_list_t* node = first; node; node = linked_list_next(node)) sum += node->number;
+	}
+	printf("%-34s %8.2f M elements/s (sum %lld)\n","Linked list iteration",(double)ELEMENTS*PASSES/seconds_since(start)/1e6,sum);
+
+	sum = 0;
+	start = clock();
+	for(int p = 0; p < PASSES; p++){
+		parse_unrolled_list(list,({ sum += ul_element; }));
+	}
+	printf("%-34s %8.2f M elements/s (sum %lld)\n","Unrolled list iteration",(double)ELEMENTS*PASSES/seconds_since(start)/1e6,sum);
+
+	// Inserts at random positions, walking from the start of the list to them
+	start = clock();
+	for(int i = 0; i < INSERTS; i++){
+		number_list_t* node = first;
+		linked_list_traverse_right(node,rand() % ELEMENTS);
+		number_list_t* new_node = malloc(sizeof(number_list_t));
+		*new_node = (number_list_t) create_singly_list_node(-i);
+		linked_list_insert_next(node,new_node);
+	}
+	printf("%-34s %8.2f K inserts/s\n","Linked list random inserts",INSERTS/seconds_since(start)/1e3);
+
+	start = clock();
+	for(int i = 0; i < INSERTS; i++){
+		insert_unrolled_list(list,rand() % ELEMENTS,-i);
+	}
+	printf("%-34s %8.2f K inserts/s\n","Unrolled list random inserts",INSERTS/seconds_since(start)/1e3);
+
+	// Only the inserted nodes were allocated one by one
+	for(number_list_t* node = first; node; ){
+		number_list_t* next = linked_list_next(node);
+		if(node < nodes || node >= nodes+ELEMENTS) free(node);
+		node = next;
+	}
+	free(nodes);
+	free(order);
+	free_unrolled_list(list);
+	return 0;
+}
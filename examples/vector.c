@@ -68,9 +68,9 @@ int main(void){
 
 	// Let's now sort those numbers, shall we?
 	// Another condition we have to input manually again
-	// If v_a > v_b, then we switch them
-	// The macro does that until the vector is sorted
-	// Very bad optimisation, but its made to work with macros, so it needs to be simple
+	// If v_a > v_b, then v_a has to be after v_b
+	// The macro uses an introsort, so it stays fast even for millions of elements
+	// (for vectors of ints or floats, radix_sort_int_vector(&vec) is even faster)
 	sort_vector(vec,(v_a > v_b));
 
 	printf("Random numbers (sorted):\n");
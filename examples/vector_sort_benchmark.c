@@ -0,0 +1,48 @@
+#define BASIC_VECTOR_TYPES
+#include "../vector.h"
+#include <time.h>
+
+// Compares the sorting macros of vector.h on random ints
+// Build it with optimizations (cmake -DCMAKE_BUILD_TYPE=Release) to get meaningful numbers
+
+// Fill vector v with n random ints
+void random_vector(struct int_vector* v, size_t n){
+	free_vector(*v);
+	srand(1234);
+	for(size_t i = 0; i < n; i++){
+		push_back(*v,rand());
+	}
+}
+
+// Check that vector v is sorted ascendingly
+_Bool is_sorted(struct int_vector v){
+	for(size_t i = 1; i < v.size; i++){
+		if(at(v,i-1) > at(v,i)) return 0;
+	}
+	return 1;
+}
+
+// Time statement s, sorting a random vector of n ints named vec
+#define bench_sort(name, n, s) ({\
+	struct int_vector vec = (struct int_vector) create_vector();\
+	random_vector(&vec,(n));\
+	clock_t start = clock();\
+	s;\
+	double ms = (double)(clock()-start)*1000.0/CLOCKS_PER_SEC;\
+	printf("%-22s n=%-9zu %10.2f ms %s\n",(name),(size_t)(n),ms,is_sorted(vec)?"":"(NOT SORTED!)");\
+	free_vector(vec);\
+})
+
+int main(void){
+	size_t sizes[] = {1000, 20000, 1000000};
+	for(int i = 0; i < sizeof(sizes)/sizeof(size_t); i++){
+		size_t n = sizes[i];
+		// The bubble sort takes minutes on a million elements, skip it
+		if(n <= 20000) bench_sort("bubble_sort_vector",n,bubble_sort_vector(vec,v_a > v_b));
+		bench_sort("sort_vector",n,sort_vector(vec,v_a > v_b));
+		bench_sort("stable_sort_vector",n,stable_sort_vector(vec,v_a > v_b));
+		bench_sort("radix_sort_int_vector",n,radix_sort_int_vector(&vec));
+		putchar('\n');
+	}
+	return 0;
+}
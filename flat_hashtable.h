@@ -0,0 +1,308 @@
+#ifndef CDS_FLAT_HASHTABLE_H
+#define CDS_FLAT_HASHTABLE_H
+
+// IMPORTANT! THIS HEADER DEPENDS ON "hashtable.h" (AND SO ON "vector.h")!
+
+// We need the hashtable allocation macros
+#include "hashtable.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// A flat hashtable is an alternative to hashtable_t for big tables where lookups must be fast
+// Instead of a vector (hashset) per index, all key/value pairs are stored in a single block of memory
+// Each slot of that block has a control byte telling if it is empty, or which pair might be in it:
+// - FLAT_HT_EMPTY : nothing was ever stored in that slot
+// - FLAT_HT_DELETED : a pair was removed from that slot (a "tombstone")
+// - 0 to 127 : the slot has a pair, the value is 7 bits of the hash of that pair
+// When looking for a pair, only the slots with the right 7 bits are compared with the condition,
+// and the control bytes are checked 16 at a time (a group), starting at the index given by the hash
+// The hashtable grows (doubles) when it is 7/8 full, so there is always an empty slot to stop a search
+//
+// It uses the same key/value pair structures and hashing functions as hashtable_t
+// BUT the hashing function is called with ~0 as the size of the hashtable, to get every bit of the hash
+// (a function ending with "return index % ht_size;" then returns the whole hash)
+// The result is mixed again, so even a poor hashing function spreads the pairs well enough
+
+// Control byte of a slot that is empty
+#define FLAT_HT_EMPTY 0x80
+
+// Control byte of a slot whose pair was removed
+// Searches can't stop at it, since pairs after it might have been added while it was full
+// It can be used again by the next pair added, and the tombstones are cleared when the hashtable is resized
+#define FLAT_HT_DELETED 0xFE
+
+// Amount of control bytes checked at a time
+#define FLAT_HT_GROUP 16
+
+// Amount of pairs a flat hashtable of capacity c can hold before growing (7/8 of it)
+// You can overwrite this macro with another (it must be smaller than c)
+#ifndef FLAT_HT_MAX_LOAD
+#define FLAT_HT_MAX_LOAD(c) ((c)-(c)/8)
+#endif
+
+// The flat hashtable structure
+typedef struct {
+	unsigned char* ctrl; // Control bytes of the slots (and a copy of the 16 first ones after the last one)
+	char* slots; // Key/value pairs, in the same block of memory as the control bytes
+	size_t size; // Amount of pairs in the hashtable
+	size_t capacity; // Amount of slots, always a power of two (0 when nothing is allocated)
+	size_t growth_left; // Amount of pairs that can be added before it has to grow
+	size_t (*hashing_func)(size_t,void*); // The hashing function
+	size_t pair_size; // Size of the key/value pairs, in bytes
+} flat_hashtable_t;
+
+/*
+Creates a flat hashtable with nothing in it
+Will set the hashing function to the value of h (same format as for create_ht)
+Argument p needs to be the size of the pairs to be allocated in the hashtable
+Memory is only allocated when adding the first pair (or with setup_flat_ht)
+*/
+#define create_flat_ht(h,p) (flat_hashtable_t){NULL,NULL,0,0,0,(h),(p)}
+
+// Frees a flat hashtable
+#define free_flat_ht(h) ({\
+	if((h).ctrl) VECTOR_FREE((h).ctrl);\
+	(h).ctrl = NULL;\
+	(h).slots = NULL;\
+	(h).size = (h).capacity = (h).growth_left = 0;\
+})
+
+// Get a pointer to the pair in slot i of the flat hashtable (not a pointer!)
+#define at_flat_ht(h,i) ((void*)((h).slots+(h).pair_size*(i)))
+
+// Tells if slot i of the flat hashtable (not a pointer!) has a pair in it
+#define is_full_flat_ht(h,i) ((h).ctrl[(i)] < 0x80)
+
+// Hash of a key/value pair, used to find its slot (upper bits) and as its control byte (7 lower bits)
+size_t flat_ht_hash(flat_hashtable_t* ht, void* element){
+	uint64_t x = ht->hashing_func(~(size_t)0,element);
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	x ^= x >> 33;
+	return (size_t)x;
+}
+
+// Bitmask of the slots of the group starting at ctrl whose control byte is b
+// With SSE2 (see HASHTABLE_SIMD in hashtable.h), the 16 control bytes are compared at once
+unsigned int flat_ht_match(const unsigned char* ctrl, unsigned char b){
+#if HASHTABLE_SIMD
+	__m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+	return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group,_mm_set1_epi8((char)b)));
+#else
+	unsigned int mask = 0;
+	for(int i = 0; i < FLAT_HT_GROUP; i++){
+		mask |= (unsigned int)(ctrl[i] == b) << i;
+	}
+	return mask;
+#endif
+}
+
+// Bitmask of the slots of the group starting at ctrl that have no pair in them
+// That is the slots whose control byte has its highest bit set
+unsigned int flat_ht_match_free(const unsigned char* ctrl){
+#if HASHTABLE_SIMD
+	return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+#else
+	unsigned int mask = 0;
+	for(int i = 0; i < FLAT_HT_GROUP; i++){
+		mask |= (unsigned int)(ctrl[i] >> 7) << i;
+	}
+	return mask;
+#endif
+}
+
+// Set the control byte of slot i, and its copy after the last slot
+void flat_ht_set_ctrl(flat_hashtable_t* ht, size_t i, unsigned char b){
+	ht->ctrl[i] = b;
+	if(i < FLAT_HT_GROUP) ht->ctrl[ht->capacity+i] = b;
+}
+
+// Find the first slot without a pair for a hash, following the same groups as a search
+// There always is one, since the hashtable is never full
+size_t flat_ht_find_free(flat_hashtable_t* ht, size_t hash){
+	size_t mask = ht->capacity-1, pos = (hash >> 7) & mask, step = 0;
+	unsigned int free_slots;
+	while(!(free_slots = flat_ht_match_free(ht->ctrl+pos))){
+		step += FLAT_HT_GROUP;
+		pos = (pos+step) & mask;
+	}
+	return (pos+__builtin_ctz(free_slots)) & mask;
+}
+
+// Reallocate the slots of the flat hashtable with a new capacity (a power of two, at least FLAT_HT_GROUP)
+// Every pair is hashed again and moved to its slot in the new block of memory
+void resize_flat_ht(flat_hashtable_t* ht, size_t new_capacity){
+	flat_hashtable_t old = *ht;
+	// The slots need to start at a well aligned address, after the control bytes
+	size_t ctrl_size = (new_capacity+FLAT_HT_GROUP+_Alignof(max_align_t)-1) & ~(_Alignof(max_align_t)-1);
+	ht->ctrl = (unsigned char*) VECTOR_REALLOC(NULL,ctrl_size+new_capacity*ht->pair_size);
+	ht->slots = (char*) ht->ctrl+ctrl_size;
+	ht->capacity = new_capacity;
+	ht->growth_left = FLAT_HT_MAX_LOAD(new_capacity)-ht->size;
+	memset(ht->ctrl,FLAT_HT_EMPTY,new_capacity+FLAT_HT_GROUP);
+	for(size_t i = 0; i < old.capacity; i++){
+		if(!is_full_flat_ht(old,i)) continue;
+		void* element = at_flat_ht(old,i);
+		size_t hash = flat_ht_hash(ht,element);
+		size_t index = flat_ht_find_free(ht,hash);
+		flat_ht_set_ctrl(ht,index,hash & 0x7F);
+		memcpy(at_flat_ht(*ht,index),element,ht->pair_size);
+	}
+	if(old.ctrl) VECTOR_FREE(old.ctrl);
+}
+
+// Setup a flat hashtable so that it can hold n pairs without growing
+void setup_flat_ht(flat_hashtable_t* ht, size_t n){
+	size_t capacity = FLAT_HT_GROUP;
+	while(FLAT_HT_MAX_LOAD(capacity) < n) capacity *= 2;
+	if(capacity > ht->capacity) resize_flat_ht(ht,capacity);
+}
+
+// Add a key/value pair to the flat hashtable
+// 1. We hash the element we want to add
+// 2. Find the first free slot in its groups
+// 3. If it's empty (not a tombstone) and the hashtable is too full, resize it and find the slot again
+//    If most of the slots are tombstones, the hashtable keeps its capacity, else it doubles
+// 4. Copy the element in that slot and set its control byte
+// Like add_ht, this does not check if the key is already in the hashtable (see put_flat_ht)
+// When using this function, please pass in a pointer to the key/value pair as the second argument
+void add_flat_ht(flat_hashtable_t* ht, void* element_to_add){
+	if(ht->hashing_func == NULL || ht->pair_size == 0) return;
+	if(ht->capacity == 0) resize_flat_ht(ht,FLAT_HT_GROUP);
+	// Step 1
+	size_t hash = flat_ht_hash(ht,element_to_add);
+	// Step 2
+	size_t index = flat_ht_find_free(ht,hash);
+	// Step 3
+	if(ht->growth_left == 0 && ht->ctrl[index] == FLAT_HT_EMPTY){
+		resize_flat_ht(ht,ht->size < FLAT_HT_MAX_LOAD(ht->capacity)/2 ? ht->capacity : ht->capacity*2);
+		index = flat_ht_find_free(ht,hash);
+	}
+	// Step 4
+	if(ht->ctrl[index] == FLAT_HT_EMPTY) ht->growth_left--;
+	flat_ht_set_ctrl(ht,index,hash & 0x7F);
+	memcpy(at_flat_ht(*ht,index),element_to_add,ht->pair_size);
+	ht->size++;
+}
+
+// Remove the pair in slot i of the flat hashtable
+// The slot becomes empty again if no search could have gone past it while it was full,
+// that is, if the 16 slots around it always had an empty one. Else, it becomes a tombstone
+void erase_flat_ht(flat_hashtable_t* ht, size_t i){
+	size_t before = (i-FLAT_HT_GROUP) & (ht->capacity-1);
+	unsigned int empty_after = flat_ht_match(ht->ctrl+i,FLAT_HT_EMPTY);
+	unsigned int empty_before = flat_ht_match(ht->ctrl+before,FLAT_HT_EMPTY);
+	if(empty_before && empty_after && __builtin_ctz(empty_after)+__builtin_clz(empty_before)-(32-FLAT_HT_GROUP) < FLAT_HT_GROUP){
+		flat_ht_set_ctrl(ht,i,FLAT_HT_EMPTY);
+		ht->growth_left++;
+	}else{
+		flat_ht_set_ctrl(ht,i,FLAT_HT_DELETED);
+	}
+	ht->size--;
+}
+
+// Find the slot of a key/value pair in the flat hashtable, evaluates to ~0 if it is not there
+// Same arguments as find_flat_ht, without the resulting pair
+// Goes through the groups of the hash, only checking the condition on slots with the same 7 bits
+// Stops at the first group that has an empty slot (the pair would have been put there)
+#define probe_flat_ht(h,e,c) ({\
+	typeof((e)) h_target = (e);\
+	typeof((e)) h_element;\
+	size_t h_found = ~0;\
+	if((h).capacity){\
+		size_t h_hash = flat_ht_hash(&(h),&h_target);\
+		size_t h_mask = (h).capacity-1, h_pos = (h_hash >> 7) & h_mask, h_step = 0;\
+		unsigned int h_match;\
+		while(1){\
+			h_match = flat_ht_match((h).ctrl+h_pos,h_hash & 0x7F);\
+			while(h_match){\
+				size_t h_i = (h_pos+__builtin_ctz(h_match)) & h_mask;\
+				h_match &= h_match-1;\
+				h_element = *(typeof((e))*) at_flat_ht((h),h_i);\
+				if((c)){\
+					h_found = h_i;\
+					break;\
+				}\
+			}\
+			if(h_found != (size_t)~0 || flat_ht_match((h).ctrl+h_pos,FLAT_HT_EMPTY)) break;\
+			h_step += FLAT_HT_GROUP;\
+			if(h_step >= (h).capacity) break;\
+			h_pos = (h_pos+h_step) & h_mask;\
+		}\
+	}\
+	h_found;\
+})
+
+// Find a key/value pair in the flat hashtable
+// Same arguments as find_ht:
+// First arg is the flat hashtable itself (not a pointer!)
+// Second arg is the element (key/value pair) we want to find in the hashtable
+// Third arg is the condition to check if elements are the one we want to find (with h_element and h_target)
+// Fourth is the "return value", basically a variable with the same type as the element we want to find
+// Fifth is the slot of the element in the hashtable (is equals to -1 when its not found), see at_flat_ht
+/* EXAMPLE:
+
+struct address element_to_get = (struct address){"A1B2C3"};
+struct address found_element;
+size_t result;
+find_flat_ht(ht, element_to_get, !strcmp(h_element.key,h_target.key), found_element, result);
+if(result == -1) printf("Address not found!\n");
+else printf("found %s : %d\n",found_element.key,found_element.addr_num);
+
+*/
+#define find_flat_ht(h,e,c,s,r) ({\
+	size_t h_slot = probe_flat_ht((h),(e),(c));\
+	(r) = h_slot;\
+	if(h_slot != (size_t)~0) (s) = *(typeof((s))*) at_flat_ht((h),h_slot);\
+})
+
+// Get a pointer to a key/value pair in the flat hashtable, like find_ptr_ht
+// The fourth argument is set to a pointer to the pair, or NULL if its not found
+// The pointer is valid until the next pair is added
+#define find_ptr_flat_ht(h,e,c,p) ({\
+	size_t h_slot = probe_flat_ht((h),(e),(c));\
+	(p) = h_slot != (size_t)~0 ? (typeof((p))) at_flat_ht((h),h_slot) : NULL;\
+})
+
+// Add a key/value pair to the flat hashtable, or replace the pair that has the same key
+// Same arguments as put_ht
+#define put_flat_ht(h,e,c) ({\
+	typeof((e)) h_put = (e);\
+	size_t h_slot = probe_flat_ht((h),h_put,(c));\
+	if(h_slot != (size_t)~0) *(typeof((e))*) at_flat_ht((h),h_slot) = h_put;\
+	else add_flat_ht(&(h),&h_put);\
+})
+
+// Remove a key/value pair from the flat hashtable
+// Same arguments as find_flat_ht, the removed pair is copied in the fourth argument (to free its key for example)
+// Fifth is the slot the element was removed from (is equals to -1 when its not found)
+#define remove_flat_ht(h,e,c,s,r) ({\
+	size_t h_slot = probe_flat_ht((h),(e),(c));\
+	(r) = h_slot;\
+	if(h_slot != (size_t)~0){\
+		(s) = *(typeof((s))*) at_flat_ht((h),h_slot);\
+		erase_flat_ht(&(h),h_slot);\
+	}\
+})
+
+// Parse through all the items of the flat hashtable
+// First arg is the flat hashtable (not a pointer!)
+// Second arg is the code to be executed for each key/value pair in the hashtable
+// Use these local variables as references:
+/*
+- h_element -> void*, is a pointer to the start of the element you are parsing
+- h_i -> size_t, is the slot of the current element
+*/
+#define parse_flat_ht(h,c) ({\
+	void* h_element;\
+	for(size_t h_i = 0; h_i < (h).capacity; h_i++){\
+		if(!is_full_flat_ht((h),h_i)) continue;\
+		h_element = at_flat_ht((h),h_i);\
+		(c);\
+	}\
+})
+
+#endif
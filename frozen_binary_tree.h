@@ -0,0 +1,144 @@
+#ifndef CDS_FROZEN_BINARY_TREE_H
+#define CDS_FROZEN_BINARY_TREE_H
+
+// IMPORTANT! THIS HEADER DEPENDS ON "binary_tree.h"!
+
+// We need the binary tree nodes and the parsing macros
+#include "binary_tree.h"
+#include <stdint.h>
+
+// A frozen binary tree is a copy of a sorted binary tree in a single array, to search it faster
+// Each node of a binary tree is its own allocation, so going down one level of the tree is usually a cache miss
+// In a frozen tree, the nodes are stored in the Eytzinger (breadth first) order, so no pointer is needed:
+// the children of node k are nodes 2k and 2k+1 (32 bits indexes, from 1), and the first levels,
+// used by every search, share a few cache lines
+// The nodes below the current one are also next to each other, so they are prefetched while the search goes down
+//
+// Here is how it looks like for a tree holding 1 to 7:
+//
+// 	index : 1 2 3 4 5 6 7
+// 	node  : 4 2 6 1 3 5 7
+//
+// The tree is copied, so it can't be changed anymore (freeze it again after adding nodes to the original one)
+// The nodes are copied whole, with their .left and .right members set to NULL, so the comparison function
+// used to sort the original tree also works with the frozen one
+/* EXAMPLE:
+
+typedef binary_tree_with(int number) number_tree_t;
+
+_Bool number_after(void* p, void* n){
+	return ((number_tree_t*)n)->number > ((number_tree_t*)p)->number;
+}
+
+number_tree_t* root = ...
+frozen_binary_tree_t frozen = freeze_binary_tree(root);
+number_tree_t key = (number_tree_t) create_binary_tree_node(42);
+number_tree_t* found = find_frozen_binary_tree(&frozen,&key,number_after);
+free_frozen_binary_tree(&frozen);
+
+*/
+// The array is allocated with BINARY_TREE_REALLOC and freed with BINARY_TREE_FREE
+
+// The frozen binary tree structure
+typedef struct {
+	char* nodes; // Node k (from 1 to count) is at nodes+k*node_size
+	uint32_t count; // Amount of nodes
+	size_t node_size; // Size of a node, in bytes
+} frozen_binary_tree_t;
+
+// Get node k of a frozen tree (from 1 to its count)
+#define at_frozen_binary_tree(f,k) ((void*)((f)->nodes+(size_t)(k)*(f)->node_size))
+
+// Copy a sorted binary tree into a frozen tree
+// The macro takes the root node (a pointer to the node type), the function takes the size of a node
+// The frozen tree is empty if the tree is, if it has 2^31-1 nodes or more, or if there is no memory left
+#define freeze_binary_tree(r) freeze_binary_tree_ex((r),sizeof(*(r)))
+frozen_binary_tree_t freeze_binary_tree_ex(void* root, size_t node_size){
+	frozen_binary_tree_t f = {NULL,0,node_size};
+	struct bt_template_t* r = root;
+	size_t count = 0;
+	parse_binary_tree_in_order(r,({ count++; }));
+	if(count == 0 || count >= UINT32_MAX/2) return f;
+	f.nodes = BINARY_TREE_REALLOC(NULL,(count+1)*node_size);
+	if(f.nodes == NULL) return f;
+	f.count = count;
+	// Walk through the array in order (the leftmost node first), while walking through the tree in order
+	uint32_t k = 1;
+	while(2*k <= f.count) k *= 2;
+	parse_binary_tree_in_order(r,({
+		struct bt_template_t* copy = at_frozen_binary_tree(&f,k);
+		memcpy(copy,bt_node,node_size);
+		copy->left = copy->right = NULL;
+		if(2*k+1 <= f.count){
+			k = 2*k+1;
+			while(2*k <= f.count) k *= 2;
+		}else{
+			while(k & 1) k >>= 1;
+			k >>= 1;
+		}
+	}));
+	return f;
+}
+
+// Free a frozen tree
+void free_frozen_binary_tree(frozen_binary_tree_t* f){
+	if(f->nodes) BINARY_TREE_FREE(f->nodes);
+	f->nodes = NULL;
+	f->count = 0;
+}
+
+// Get the index of the first node that is not before key in a frozen tree (0 if all the nodes are before it)
+// key is a node with the members used by the comparison function set
+// The search always goes down to the last level, without branching on the result of the comparisons
+uint32_t lower_bound_index_frozen_binary_tree(frozen_binary_tree_t* f, void* key, _Bool (*comparison_func)(void*,void*)){
+	uint32_t k = 1;
+	while(k <= f->count){
+		// The 16 nodes 4 levels below are next to each other
+		if(16*(size_t)k <= f->count) __builtin_prefetch(at_frozen_binary_tree(f,16*k));
+		k = 2*k+comparison_func(at_frozen_binary_tree(f,k),key);
+	}
+	// Go back up to the last node where the search went left
+	return k >> __builtin_ffs(~k);
+}
+
+// Get the first node that is not before key in a frozen tree (NULL if all the nodes are before it)
+void* lower_bound_frozen_binary_tree(frozen_binary_tree_t* f, void* key, _Bool (*comparison_func)(void*,void*)){
+	uint32_t k = lower_bound_index_frozen_binary_tree(f,key,comparison_func);
+	return k ? at_frozen_binary_tree(f,k) : NULL;
+}
+
+// Find a node equal to key in a frozen tree (NULL if there is none)
+// Two nodes are equal when neither goes after the other
+void* find_frozen_binary_tree(frozen_binary_tree_t* f, void* key, _Bool (*comparison_func)(void*,void*)){
+	void* node = lower_bound_frozen_binary_tree(f,key,comparison_func);
+	return node && !comparison_func(key,node) ? node : NULL;
+}
+
+// Get the index of the node after node k in a frozen tree (0 if it is the last one)
+uint32_t next_index_frozen_binary_tree(frozen_binary_tree_t* f, uint32_t k){
+	if(2*k+1 <= f->count){
+		k = 2*k+1;
+		while(2*k <= f->count) k *= 2;
+		return k;
+	}
+	while(k & 1) k >>= 1;
+	return k >> 1;
+}
+
+// Parse through every node of a frozen tree that is not before key, in order
+// Second arg is the key (NULL to start from the first node), third arg is the comparison function
+// Last arg is the code to be executed for each node
+// The local variable bt_node is a void pointer to the node you are parsing, you can use break to stop
+#define parse_frozen_binary_tree(f,key,cf,c) ({\
+	frozen_binary_tree_t* bt_frozen = (f);\
+	void* bt_key = (key);\
+	uint32_t bt_k = bt_frozen->count ? 1 : 0;\
+	if(bt_key) bt_k = lower_bound_index_frozen_binary_tree(bt_frozen,bt_key,(cf));\
+	else while(bt_k && 2*bt_k <= bt_frozen->count) bt_k *= 2;\
+	for(; bt_k; bt_k = next_index_frozen_binary_tree(bt_frozen,bt_k)){\
+		void* bt_node = at_frozen_binary_tree(bt_frozen,bt_k);\
+		(c);\
+	}\
+})
+
+#endif
@@ -14,6 +14,7 @@
 // We need the vector macros
 #include "vector.h"
 #include <string.h>
+#include <stdint.h>
 
 // To use the hashtable provided by this header, you will have to create your own key/value pair structure
 // Please add this member to the key/value pair struct
@@ -30,11 +31,135 @@ struct hashpair{
 }
 */
 
+// Hashing functions
+// Fast hashes of bytes, strings, integers and pointers, with a good distribution:
+// changing a single bit of the input changes about half of the bits of the hash
+// hash_bytes is based on wyhash (it reads 8 or 16 bytes at a time, and mixes them with 64x64 -> 128 bit multiplications)
+
+// Reduce a full hash to an index smaller than size
+// A power of two size only keeps the lower bits of the hash, which is a lot faster than %
+#define reduce_hash_ht(h,size) (((size) & ((size)-1)) ? (h) % (size) : (h) & ((size)-1))
+
+// Multiply a and b and mix the 64 upper and lower bits of the result
+uint64_t hash_mix(uint64_t a, uint64_t b){
+#ifdef __SIZEOF_INT128__
+	__uint128_t r = (__uint128_t)a*b;
+	return (uint64_t)r ^ (uint64_t)(r >> 64);
+#else
+	uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t)a, lb = (uint32_t)b;
+	uint64_t rh = ha*hb, rm0 = ha*lb, rm1 = hb*la, rl = la*lb, t = rl+(rm0 << 32), c = t < rl;
+	uint64_t lo = t+(rm1 << 32);
+	c += lo < t;
+	return lo ^ (rh+(rm0 >> 32)+(rm1 >> 32)+c);
+#endif
+}
+
+// Read 8 / 4 bytes from any address
+uint64_t hash_read64(const unsigned char* p){ uint64_t v; memcpy(&v,p,8); return v; }
+uint64_t hash_read32(const unsigned char* p){ uint32_t v; memcpy(&v,p,4); return v; }
+
+// Hash len bytes starting at key
+uint64_t hash_bytes(const void* key, size_t len){
+	const uint64_t s0 = 0xa0761d6478bd642fULL, s1 = 0xe7037ed1a0b428dbULL, s2 = 0x8ebc6af09c88c6e3ULL, s3 = 0x589965cc75374cc3ULL;
+	const unsigned char* p = (const unsigned char*) key;
+	uint64_t seed = hash_mix(s0,s1), a, b;
+	if(len <= 16){
+		if(len >= 4){
+			a = (hash_read32(p) << 32) | hash_read32(p+((len >> 3) << 2));
+			b = (hash_read32(p+len-4) << 32) | hash_read32(p+len-4-((len >> 3) << 2));
+		}else if(len > 0){
+			a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len-1];
+			b = 0;
+		}else a = b = 0;
+	}else{
+		size_t i = len;
+		if(i > 48){
+			uint64_t seed1 = seed, seed2 = seed;
+			do{
+				seed = hash_mix(hash_read64(p) ^ s1,hash_read64(p+8) ^ seed);
+				seed1 = hash_mix(hash_read64(p+16) ^ s2,hash_read64(p+24) ^ seed1);
+				seed2 = hash_mix(hash_read64(p+32) ^ s3,hash_read64(p+40) ^ seed2);
+				p += 48;
+				i -= 48;
+			}while(i > 48);
+			seed ^= seed1 ^ seed2;
+		}
+		while(i > 16){
+			seed = hash_mix(hash_read64(p) ^ s1,hash_read64(p+8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+		// The last 16 bytes, some of them might have been read already
+		a = hash_read64(p+i-16);
+		b = hash_read64(p+i-8);
+	}
+	return hash_mix(s1 ^ len,hash_mix(a ^ s1,b ^ seed));
+}
+
+// Hash a '\0' terminated string
+uint64_t hash_string(const char* str){
+	return hash_bytes(str,strlen(str));
+}
+
+// Hash an integer (multiply-xorshift)
+uint64_t hash_u64(uint64_t x){
+	x ^= x >> 32;
+	x *= 0xd6e8feb86659fd93ULL;
+	x ^= x >> 32;
+	x *= 0xd6e8feb86659fd93ULL;
+	return x ^ (x >> 32);
+}
+
+// Hash a pointer (its address, not what it points to)
+uint64_t hash_ptr(const void* ptr){
+	return hash_u64((uint64_t)(uintptr_t)ptr);
+}
+
+// Ready to use hashing functions for create_ht and create_flat_ht
+// They hash the key, which must be the first member of the key/value pair
+// hash_string_key_ht : char* key (the string it points to)
+// hash_char_array_key_ht : char key[N] ('\0' terminated)
+// hash_u32_key_ht : uint32_t, int or unsigned int key
+// hash_u64_key_ht : uint64_t or size_t key
+// hash_ptr_key_ht : any pointer key (its address)
+/* EXAMPLE:
+typedef struct{
+	char* key; // Their name
+	unsigned int age; // Their age
+} person_pair_t;
+
+hashtable_t ht = create_ht(hash_string_key_ht,16,sizeof(person_pair_t));
+*/
+size_t hash_string_key_ht(size_t size, void* element){ return reduce_hash_ht((size_t)hash_string(*(char**)element),size); }
+size_t hash_char_array_key_ht(size_t size, void* element){ return reduce_hash_ht((size_t)hash_string((char*)element),size); }
+size_t hash_u32_key_ht(size_t size, void* element){ return reduce_hash_ht((size_t)hash_u64(*(uint32_t*)element),size); }
+size_t hash_u64_key_ht(size_t size, void* element){ return reduce_hash_ht((size_t)hash_u64(*(uint64_t*)element),size); }
+size_t hash_ptr_key_ht(size_t size, void* element){ return reduce_hash_ht((size_t)hash_ptr(*(void**)element),size); }
+
+// Define a hashing function called name that hashes the n first bytes of the key/value pairs
+// For keys that are a fixed size structure or array, at the start of the pair
+/* EXAMPLE:
+typedef struct{
+	unsigned char key[6]; // A MAC address
+	char* vendor;
+} mac_pair_t;
+
+define_prefix_hash_ht(hash_mac_pair,6) // Outside of any function
+hashtable_t ht = create_ht(hash_mac_pair,16,sizeof(mac_pair_t));
+*/
+#define define_prefix_hash_ht(name,n) size_t name(size_t size, void* element){ return reduce_hash_ht((size_t)hash_bytes(element,(n)),size); }
+
 // Vector of key/value pairs, is allocated by the hashtable dynamically
 // This vector uses a char array, though it does not act like a character string
+// It is a capacity vector (see vector.h), so adding pairs to it does not always reallocate
+// The hash of every pair is kept in hashes, at the same index as the pair
+// so lookups can skip pairs with another hash, and rehashing never calls the hashing function again
+// Because of that, only change hashsets with the functions and macros of this header
 typedef struct {
 	char* arr;
 	size_t size;
+	size_t capacity;
+	size_t* hashes;
 } hashset_t;
 
 // This is basically a vector of hashets which are also vectors
@@ -44,6 +169,10 @@ typedef struct {
 	size_t (*hashing_func)(size_t,void*); // The hashing function
 	unsigned int max_size; // The max amount of pairs in a single index (cannot be 0)
 	size_t pair_size; // Size of the key/value pairs, in bytes
+	unsigned int rehash_step; // Hashsets moved by each add_ht during an incremental rehash (0 = rehash everything at once)
+	hashset_t* old_arr; // Hashsets still being moved to arr during an incremental rehash (NULL otherwise)
+	size_t old_size; // Amount of hashsets in old_arr
+	size_t rehash_pos; // Index of the next hashset of old_arr to move
 } hashtable_t;
 
 /*
@@ -55,100 +184,269 @@ h must be a function with this format:
 
 size_t hashing_func(size_t size_of_hashtable, void* element_to_be_indexed){
 	-- your hashing code --
-	return hash key;
+	return hash key % size_of_hashtable;
 }
+
+The hashtable calls it once per pair with ~0 as the size, to get every bit of the hash
+(a function ending with "return index % ht_size;" then returns the whole hash)
+That hash is kept with the pair, and is reduced to the index of its hashset (see reduce_hash_ht)
+
+You can also use one of the hashing functions above, like hash_string_key_ht
+The amount of hashsets is always a power of two, so the index is found with a mask instead of %
+
+When a hashset gets more than m pairs, the hashtable doubles its amount of hashsets
+and moves every pair to its new hashset (a rehash)
+By default, that is done all at once by the add_ht call that made the hashset too big
+To spread that cost over the next calls instead, set the rehash_step member of the hashtable:
+
+hashtable_t ht = create_ht(hashfunc,16,sizeof(person_pair_t));
+ht.rehash_step = 4; // Every add_ht moves 4 hashsets to the bigger hashtable
 */
 #define create_ht(h,m,p) (hashtable_t){NULL,0,(h),(m),(p)};
 
+// Frees a hashset of the hashtable, with its hashes
+#define free_hs(h) ({\
+	free_vector((h));\
+	if((h).hashes) VECTOR_FREE((h).hashes);\
+	(h).hashes = NULL;\
+	(h).capacity = 0;\
+})
+
 // Frees a hashtable
 #define free_ht(h) ({\
 	for(int h_i = 0; h_i < (h).size; h_i++){\
-		free_vector((h).arr[h_i]);\
+		free_hs((h).arr[h_i]);\
 	}\
 	free_vector((h));\
 	(h).arr = NULL;\
 	(h).size = 0;\
+	if((h).old_arr){\
+		for(size_t h_i = 0; h_i < (h).old_size; h_i++){\
+			free_hs((h).old_arr[h_i]);\
+		}\
+		VECTOR_FREE((h).old_arr);\
+		(h).old_arr = NULL;\
+	}\
+	(h).old_size = (h).rehash_pos = 0;\
 })
 
+// Get the full hash of a key/value pair, by calling the hashing function with ~0 as the size
+#define hash_ht(ht,e) ((ht)->hashing_func(~(size_t)0,(e)))
+
 // Add extra hashsets to the hashtable
 void add_hashsets_ht(hashtable_t* ht, int size){
-	hashset_t hs = (hashset_t) create_vector();
-	for(int i = 0; i < size; i++){
-		push_back(*ht,hs);
+	ht->arr = VECTOR_REALLOC(ht->arr,sizeof(hashset_t)*(ht->size+size));
+	memset(ht->arr+ht->size,0,sizeof(hashset_t)*size);
+	ht->size += size;
+}
+
+// Copy a key/value pair and its hash at the end of a hashset
+void add_hs(hashtable_t* ht, hashset_t* hs, void* element, size_t hash){
+	size_t old_capacity = hs->arr ? hs->capacity : 0;
+	add_size_vector_cap(*hs,ht->pair_size);
+	if(hs->capacity != old_capacity || hs->hashes == NULL)
+		hs->hashes = VECTOR_REALLOC(hs->hashes,sizeof(size_t)*hs->capacity);
+	memcpy(at_sized(*hs,hs->size-1,ht->pair_size),element,ht->pair_size);
+	hs->hashes[hs->size-1] = hash;
+}
+
+// Remove the pair at index i of a hashset
+// The last pair (and its hash) takes its place, so nothing is shifted
+void erase_hs(hashtable_t* ht, hashset_t* hs, size_t i){
+	if(i != hs->size-1){
+		memcpy(at_sized(*hs,i,ht->pair_size),at_sized(*hs,hs->size-1,ht->pair_size),ht->pair_size);
+		hs->hashes[i] = hs->hashes[hs->size-1];
+	}
+	hs->size--;
+}
+
+// Move every pair of hashset i of old_arr to its hashset in arr, during an incremental rehash
+// Does nothing if that hashset was already moved
+void move_hashset_ht(hashtable_t* ht, size_t i){
+	hashset_t* hs = &ht->old_arr[i];
+	for(size_t j = 0; j < hs->size; j++){
+		add_hs(ht,&at(*ht,reduce_hash_ht(hs->hashes[j],ht->size)),at_sized(*hs,j,ht->pair_size),hs->hashes[j]);
+	}
+	free_hs(*hs);
+}
+
+// Move the next n hashsets of an incremental rehash, and end it if they were the last ones
+// Pass ~0 as n to end it right away
+void rehash_step_ht(hashtable_t* ht, size_t n){
+	if(ht->old_arr == NULL) return;
+	for(; n && ht->rehash_pos < ht->old_size; n--){
+		move_hashset_ht(ht,ht->rehash_pos++);
+	}
+	if(ht->rehash_pos == ht->old_size){
+		VECTOR_FREE(ht->old_arr);
+		ht->old_arr = NULL;
+		ht->old_size = ht->rehash_pos = 0;
 	}
 }
 
+// Copy every pair (and its hash) of the from_size hashsets in from to their hashset in the hashtable
+// 1. Count how many pairs go in each hashset (from the hashes kept with the pairs)
+// 2. Allocate every empty hashset once, with the exact size it needs
+// 3. Copy the pairs and their hashes to their hashset
+// So there is no allocation per pair, only one per hashset, and the hashing function is never called
+// The hashsets of the hashtable must be empty, and the ones in from are left as they are
+void fill_hashsets_ht(hashtable_t* ht, hashset_t* from, size_t from_size){
+	// Step 1
+	for(size_t i = 0; i < from_size; i++){
+		for(size_t j = 0; j < from[i].size; j++){
+			at(*ht,reduce_hash_ht(from[i].hashes[j],ht->size)).size++;
+		}
+	}
+	// Step 2
+	for(size_t i = 0; i < ht->size; i++){
+		hashset_t* hs = &at(*ht,i);
+		if(hs->size == 0) continue;
+		reserve_vector_sized(*hs,hs->size,ht->pair_size);
+		hs->hashes = VECTOR_REALLOC(NULL,sizeof(size_t)*hs->capacity);
+		hs->size = 0;
+	}
+	// Step 3
+	for(size_t i = 0; i < from_size; i++){
+		for(size_t j = 0; j < from[i].size; j++){
+			hashset_t* hs = &at(*ht,reduce_hash_ht(from[i].hashes[j],ht->size));
+			memcpy(at_sized(*hs,hs->size,ht->pair_size),at_sized(from[i],j,ht->pair_size),ht->pair_size);
+			hs->hashes[hs->size++] = from[i].hashes[j];
+		}
+	}
+}
+
+// Change the amount of hashsets of the hashtable, moving every pair to its new hashset
+// If rehash_step is 0, this is done right away, with fill_hashsets_ht
+// Else, the old hashsets are kept in old_arr, and moved a few at a time by the next calls to add_ht
+void rehash_ht(hashtable_t* ht, size_t new_size){
+	if(new_size == 0 || ht->hashing_func == NULL) return;
+	rehash_step_ht(ht,~0);
+	hashset_t* old_arr = ht->arr;
+	size_t old_size = ht->size;
+	ht->arr = NULL;
+	ht->size = 0;
+	add_hashsets_ht(ht,new_size);
+	if(ht->rehash_step){
+		ht->old_arr = old_arr;
+		ht->old_size = old_size;
+		ht->rehash_pos = 0;
+		return;
+	}
+	fill_hashsets_ht(ht,old_arr,old_size);
+	for(size_t i = 0; i < old_size; i++){
+		free_hs(old_arr[i]);
+	}
+	if(old_arr) VECTOR_FREE(old_arr);
+}
+
 // Setup a hashtable with specified starting size
+// The size is rounded up to a power of two
 void setup_ht(hashtable_t* ht, int start_size){
 	free_ht(*ht);
-	add_hashsets_ht(ht,start_size);
+	int size = 1;
+	while(size < start_size) size *= 2;
+	add_hashsets_ht(ht,size);
+}
+
+// Add a key/value pair whose hash is already known to the hashtable (steps 2 to 4 of add_ht below)
+// The hash must be what the hashing function returns with ~0 as the size (see hash_ht)
+void add_hashed_ht(hashtable_t* ht, void* element_to_add, size_t hash){
+	if(ht->arr == NULL || ht->size == 0 || ht->hashing_func == NULL || ht->max_size == 0) return;
+	// Keep moving the hashsets of an incremental rehash
+	rehash_step_ht(ht,ht->rehash_step);
+	// Step 2
+	hashset_t* hs = &at(*ht,reduce_hash_ht(hash,ht->size));
+	// Step 3
+	add_hs(ht,hs,element_to_add,hash);
+	// Step 4
+	if(hs->size > ht->max_size && ht->old_arr == NULL){
+		rehash_ht(ht,ht->size*2); // Double the size of the hashtable
+	}
 }
 
 // Add a key/value pair to the hashtable
-// 1. We get the hash index from the element we want to add
-// 2. Check if the index is valid, if not throw an error
-// 3. Add the element to the hashset with the index we just got
-// 4. Check if the max size is respected, if not rearrange the hashtable
+// 1. We get the hash from the element we want to add
+// 2. Reduce it to the index of its hashset
+// 3. Add the element (and its hash) to the hashset with the index we just got
+// 4. Check if the max size is respected, if not rearrange the hashtable (see rehash_ht)
 // When using this function, please pass in a pointer to the key/value pair as the second argument
 void add_ht(hashtable_t* ht, void* element_to_add){
-	if(ht->arr == NULL || ht->size == 0 || ht->hashing_func == NULL || ht->max_size == 0) return;
+	if(ht->hashing_func == NULL) return;
 	// Step 1
-	size_t index = ht->hashing_func(ht->size,element_to_add);
+	add_hashed_ht(ht,element_to_add,hash_ht(ht,element_to_add));
+}
+
+// Build the hashtable from an array of count key/value pairs, replacing what was in it
+// Much faster than calling add_ht for every pair, for big amounts of pairs:
+// 1. Hash every pair once
+// 2. Pick the amount of hashsets right away, so that they are half full on average (no doubling)
+// 3. Allocate every hashset once and copy the pairs in them (see fill_hashsets_ht)
+// 4. In the rare case a hashset still has more than max_size pairs, double the size (see rehash_ht)
+// 	until it fits, or until doubling doesn't make the biggest hashset smaller (pairs with the same hash)
+// Like add_ht, this does not check if the same key is in the array twice
+/* EXAMPLE:
+
+person_pair_t* people = load_people(&count); // An array of count pairs
+hashtable_t ht = create_ht(hash_char_array_key_ht,16,sizeof(person_pair_t));
+build_ht(&ht,people,count);
+
+*/
+void build_ht(hashtable_t* ht, void* pairs, size_t count){
+	if(ht->hashing_func == NULL || ht->max_size == 0) return;
+	free_ht(*ht);
+	// Step 1
+	hashset_t all = (hashset_t){pairs,count,count,VECTOR_REALLOC(NULL,sizeof(size_t)*(count ? count : 1))};
+	for(size_t i = 0; i < count; i++){
+		all.hashes[i] = hash_ht(ht,at_sized(all,i,ht->pair_size));
+	}
 	// Step 2
-	if(index >= ht->size){
-		printf("ERROR: Index provided by hashing function is out of range!\n");
-		return;
-	};
+	size_t size = 1, per_hashset = ht->max_size > 1 ? ht->max_size/2 : 1;
+	while(size*per_hashset < count) size *= 2;
+	add_hashsets_ht(ht,size);
 	// Step 3
-	hashset_t* hs = &at(*ht,index);
-	add_size_vector(*hs, ht->pair_size);
-	memcpy(
-		at_sized(*hs, hs->size-1, ht->pair_size),
-		element_to_add,
-		ht->pair_size
-	);
+	fill_hashsets_ht(ht,&all,1);
+	VECTOR_FREE(all.hashes);
 	// Step 4
-	if(hs->size > ht->max_size){
-		size_t old_size = ht->size;
-		add_hashsets_ht(ht,ht->size); // Double the size of the hashtable
-		for(size_t i = 0; i < old_size; i++){
-			hashset_t* hs = &at(*ht,i);
-			if(hs->size == 0) continue;
-			for(size_t j = hs->size-1; j >= 0 && j < ~0; j--){
-				char* element = (char*)malloc(ht->pair_size);
-				memcpy(element,at_sized(*hs,j,ht->pair_size),ht->pair_size);
-				size_t new_index = ht->hashing_func(ht->size,(void*)element);
-				if(new_index != i){
-					pop_at_sized(*hs,j,ht->pair_size);
-					add_size_vector(at(*ht,new_index),ht->pair_size);
-					memcpy(
-						at_sized(at(*ht,new_index),at(*ht,new_index).size-1,ht->pair_size),
-						element,
-						ht->pair_size
-					);
-				}
-				free(element);
-			}
-		}
+	size_t largest = 0;
+	for(size_t i = 0; i < ht->size; i++) if(at(*ht,i).size > largest) largest = at(*ht,i).size;
+	unsigned int rehash_step = ht->rehash_step;
+	ht->rehash_step = 0;
+	while(largest > ht->max_size){
+		size_t previous = largest;
+		rehash_ht(ht,ht->size*2);
+		largest = 0;
+		for(size_t i = 0; i < ht->size; i++) if(at(*ht,i).size > largest) largest = at(*ht,i).size;
+		// Pairs with the same hash are never split, so keep the oversized hashset (like add_hashed_ht does)
+		if(largest >= previous) break;
 	}
+	ht->rehash_step = rehash_step;
 }
 
-// Get the vector where the pair passed as 2nd argument should be
-// 1. Get the hash index from the element we want to find
-// 2. Check if index is valid, throw an error if not
-// 3. Just return the hashset as a pointer
-hashset_t* get_ht(hashtable_t* ht, void* element_to_get){
+// Get the vector where the pairs with the given hash are
+// During an incremental rehash, the old hashset of that hash is moved first
+hashset_t* hashset_of_ht(hashtable_t* ht, size_t hash){
+	if(ht->arr == NULL || ht->size == 0 || ht->max_size == 0) return NULL;
+	// During an incremental rehash, the pair might still be in the old hashsets
+	if(ht->old_arr) move_hashset_ht(ht,reduce_hash_ht(hash,ht->old_size));
+	return &at(*ht,reduce_hash_ht(hash,ht->size));
+}
+
+// Get the vector where the pair passed as 2nd argument should be, and set *hash to the hash of that pair
+// 1. Get the hash from the element we want to find
+// 2. Get the index of the hashset from the hash
+// 3. Just return the hashset as a pointer (see hashset_of_ht)
+hashset_t* get_hashed_ht(hashtable_t* ht, void* element_to_get, size_t* hash){
 	if(ht->arr == NULL || ht->size == 0 || ht->hashing_func == NULL || ht->max_size == 0) return NULL;
 	// Step 1
-	size_t index = ht->hashing_func(ht->size,element_to_get);
-	// Step 2
-	if(index >= ht->size){
-		printf("ERROR: Index provided by hashing function is out of range!\n");
-		return NULL;
-	}
-	// Step 3
-	hashset_t* hs = &at(*ht,index);
-	return hs;
+	*hash = hash_ht(ht,element_to_get);
+	// Steps 2 and 3
+	return hashset_of_ht(ht,*hash);
+}
+
+// Get the vector where the pair passed as 2nd argument should be
+hashset_t* get_ht(hashtable_t* ht, void* element_to_get){
+	size_t hash;
+	return get_hashed_ht(ht,element_to_get,&hash);
 }
 
 // Find an key/value pair in a hashset
@@ -198,6 +496,60 @@ else{
 	}\
 })
 
+// SIMD probing
+// When compiling for a CPU with SSE2 (every x86-64 CPU) or AVX2 (-mavx2 or -march=native),
+// the hashes of a hashset are compared 2 or 4 at a time, and the control bytes of
+// a flat hashtable 16 at a time, with a single instruction
+// Define HASHTABLE_NO_SIMD before including this header to always use the portable code
+#if !defined(HASHTABLE_NO_SIMD) && (defined(__SSE2__) || defined(__AVX2__))
+#include <immintrin.h>
+#define HASHTABLE_SIMD 1
+#else
+#define HASHTABLE_SIMD 0
+#endif
+
+// Index of the first hash equal to hash in hashes[from..size), or size if there is none
+size_t find_hash_hs(const size_t* hashes, size_t from, size_t size, size_t hash){
+#if HASHTABLE_SIMD && SIZE_MAX == UINT64_MAX
+#ifdef __AVX2__
+	__m256i target4 = _mm256_set1_epi64x((long long)hash);
+	for(; from+4 <= size; from += 4){
+		__m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(hashes+from)),target4);
+		int mask = _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+		if(mask) return from+__builtin_ctz(mask);
+	}
+#endif
+	// SSE2 can only compare 32 bits at a time, both halves of a hash have to be equal
+	__m128i target2 = _mm_set1_epi64x((long long)hash);
+	for(; from+2 <= size; from += 2){
+		__m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(hashes+from)),target2);
+		eq = _mm_and_si128(eq,_mm_shuffle_epi32(eq,0xB1));
+		int mask = _mm_movemask_pd(_mm_castsi128_pd(eq));
+		if(mask) return from+__builtin_ctz(mask);
+	}
+#endif
+	for(; from < size; from++){
+		if(hashes[from] == hash) return from;
+	}
+	return size;
+}
+
+// Find a key/value pair in a hashset, like find_hs, knowing the hash (x) of the pair
+// The condition is only checked for the pairs that have the same hash, and they are the only ones copied
+#define find_hs_hashed(h,e,c,r,x) ({\
+	typeof((e)) h_target = (e);\
+	typeof((e)) h_element;\
+	size_t h_hash = (x);\
+	r = ~0;\
+	for(size_t h_i = 0; (h_i = find_hash_hs((h).hashes,h_i,(h).size,h_hash)) < (h).size; h_i++){\
+		h_element = * (typeof((e))*) at_sized((h),h_i,sizeof((e)));\
+		if((c)){\
+			r = h_i;\
+			break;\
+		}\
+	}\
+})
+
 // Find a key/value pair in the hashtable
 // First arg is the hashtable itself (not a pointer!)
 // Second arg is the element (key/value pair) we want to find in the hashtable
@@ -224,14 +576,131 @@ else printf("found %s : %d\n",found_element.key,found_element.addr_num);
 
 */
 #define find_ht(h,e,c,s,r) ({\
-	hashset_t* hs_find = get_ht(&(h),&(e));\
+	size_t h_find_hash;\
+	hashset_t* hs_find = get_hashed_ht(&(h),&(e),&h_find_hash);\
 	if(hs_find == NULL) { printf("Failed to get hashset index!\n"); (r) = ~0; }\
 	else{\
-		find_hs(*hs_find,(e),(c),(r));\
+		find_hs_hashed(*hs_find,(e),(c),(r),h_find_hash);\
 		if((r) != -1) (s) = *(typeof((s))*)at_sized(*hs_find,(r),sizeof((e)));\
 	}\
 })
 
+// Amount of keys find_many_ht hashes and prefetches before comparing any of them
+#ifndef HASHTABLE_BATCH
+#define HASHTABLE_BATCH 16
+#endif
+
+// Ask the CPU to start loading the memory at p into its cache, without waiting for it
+#define prefetch_ht(p) __builtin_prefetch((p))
+
+// Find n key/value pairs in the hashtable at once
+// On big hashtables, most of the time of find_ht is spent waiting for the hashset (and its hashes) to be loaded from memory
+// This loads the ones of HASHTABLE_BATCH keys at the same time instead, for each batch of keys:
+// 1. Hash every key, and prefetch its hashset
+// 2. Prefetch the hashes and the pairs of every hashset
+// 3. Find every key in its hashset (see find_hs_hashed), by then most of the memory is already in the cache
+// First arg is the hashtable itself (not a pointer!)
+// Second arg is an array of n elements (key/value pairs) we want to find
+// Third arg is n, the amount of elements to find
+// Fourth arg is the condition, same as find_ht
+// Fifth is an array of n elements, where the pairs found are copied
+// Sixth is an array of n size_t, the index of each element in its hashset (is equals to -1 when its not found)
+/* EXAMPLE:
+
+struct address to_get[3] = {{"A1B2C3"},{"D4E5F6"},{"G7H8I9"}};
+struct address found[3];
+size_t results[3];
+find_many_ht(ht, to_get, 3, !strcmp(h_element.key,h_target.key), found, results);
+for(int i = 0; i < 3; i++) if(results[i] != -1) printf("found %s : %d\n",found[i].key,found[i].addr_num);
+
+*/
+#define find_many_ht(h,e,n,c,s,r) ({\
+	hashset_t* h_batch_hs[HASHTABLE_BATCH];\
+	size_t h_batch_hash[HASHTABLE_BATCH];\
+	size_t h_n = (n);\
+	for(size_t h_b = 0; h_b < h_n; h_b += HASHTABLE_BATCH){\
+		size_t h_count = h_n-h_b < HASHTABLE_BATCH ? h_n-h_b : HASHTABLE_BATCH;\
+		for(size_t h_k = 0; h_k < h_count; h_k++){\
+			h_batch_hash[h_k] = (h).hashing_func ? hash_ht(&(h),&(e)[h_b+h_k]) : 0;\
+			h_batch_hs[h_k] = (h).hashing_func ? hashset_of_ht(&(h),h_batch_hash[h_k]) : NULL;\
+			if(h_batch_hs[h_k]) prefetch_ht(h_batch_hs[h_k]);\
+		}\
+		for(size_t h_k = 0; h_k < h_count; h_k++){\
+			if(h_batch_hs[h_k] == NULL || h_batch_hs[h_k]->size == 0) continue;\
+			prefetch_ht(h_batch_hs[h_k]->hashes);\
+			prefetch_ht(h_batch_hs[h_k]->arr);\
+		}\
+		for(size_t h_k = 0; h_k < h_count; h_k++){\
+			(r)[h_b+h_k] = ~0;\
+			if(h_batch_hs[h_k] == NULL) continue;\
+			find_hs_hashed(*h_batch_hs[h_k],(e)[h_b+h_k],(c),(r)[h_b+h_k],h_batch_hash[h_k]);\
+			if((r)[h_b+h_k] != -1) (s)[h_b+h_k] = *(typeof((s)[0])*)at_sized(*h_batch_hs[h_k],(r)[h_b+h_k],(h).pair_size);\
+		}\
+	}\
+})
+
+// Get a pointer to a key/value pair in the hashtable, so it can be read or changed without copying it
+// First arg is the hashtable itself (not a pointer!)
+// Second arg is the element (key/value pair) we want to find in the hashtable
+// Third arg is the condition to check if elements in hashsets are the one we want to find
+// Fourth is the "return value", a pointer to the type of the element we want to find (NULL when its not found)
+// The pointer is valid until the next pair is added or removed
+/* EXAMPLE:
+
+struct address element_to_get = (struct address){"A1B2C3"};
+struct address* found_element;
+find_ptr_ht(ht, element_to_get, !strcmp(h_element.key,h_target.key), found_element);
+if(found_element) found_element->addr_num++;
+
+*/
+#define find_ptr_ht(h,e,c,p) ({\
+	typeof((e)) h_get = (e);\
+	size_t h_index, h_get_hash;\
+	hashset_t* hs_get = get_hashed_ht(&(h),&h_get,&h_get_hash);\
+	(p) = NULL;\
+	if(hs_get){\
+		find_hs_hashed(*hs_get,h_get,(c),h_index,h_get_hash);\
+		if(h_index != (size_t)~0) (p) = (typeof((p))) at_sized(*hs_get,h_index,(h).pair_size);\
+	}\
+})
+
+// Add a key/value pair to the hashtable, or replace the pair that has the same key
+// First arg is the hashtable itself (not a pointer!)
+// Second arg is the element (key/value pair) to add, it's copied in the hashtable
+// Third arg is the condition to check if elements in hashsets have the same key
+/* EXAMPLE:
+
+struct address new_address = (struct address){"A1B2C3",42};
+put_ht(ht, new_address, !strcmp(h_element.key,h_target.key));
+
+*/
+#define put_ht(h,e,c) ({\
+	typeof((e)) h_put = (e);\
+	typeof((e))* h_old;\
+	find_ptr_ht((h),h_put,(c),h_old);\
+	if(h_old) *h_old = h_put;\
+	else add_ht(&(h),&h_put);\
+})
+
+// Remove a key/value pair from the hashtable
+// Same arguments as find_ht, the removed pair is copied in the fourth argument (to free its key for example)
+// Fifth is the index of the element in the hashset it was removed from (is equals to -1 when its not found)
+// The last pair of the hashset takes the place of the removed one, so nothing is shifted
+// and lookups are as fast as if the pair was never added
+#define remove_ht(h,e,c,s,r) ({\
+	typeof((e)) h_remove = (e);\
+	size_t h_remove_hash;\
+	hashset_t* hs_remove = get_hashed_ht(&(h),&h_remove,&h_remove_hash);\
+	(r) = ~0;\
+	if(hs_remove){\
+		find_hs_hashed(*hs_remove,h_remove,(c),(r),h_remove_hash);\
+		if((r) != -1){\
+			(s) = *(typeof((s))*) at_sized(*hs_remove,(r),(h).pair_size);\
+			erase_hs(&(h),hs_remove,(r));\
+		}\
+	}\
+})
+
 // Parse through all the items of the hashtable
 // First arg is the hashtable (not a pointer!)
 // Second arg is the code to be executed for each key/value pair in the hashtable
@@ -243,12 +712,14 @@ NOTE: to convert h_element to the key/value pair you are using, simply use this
 - h_i -> size_t, is the index of the current hashset inside of the hashtable
 - h_hs -> hashset_t*, is the pointer to the current hashset
 - h_j -> size_t, is the index of the current element inside of the hashset
+During an incremental rehash, the pairs that were not moved yet are parsed last,
+h_hs then points to their hashset in old_arr
 */
 #define parse_ht(h,c) ({\
 	hashset_t* h_hs;\
 	void* h_element;\
-	for(size_t h_i = 0; h_i < (h).size; h_i++){\
-		h_hs = &at((h),h_i);\
+	for(size_t h_i = 0; h_i < (h).size+(h).old_size; h_i++){\
+		h_hs = h_i < (h).size ? &at((h),h_i) : &(h).old_arr[h_i-(h).size];\
 		for(size_t h_j = 0; h_j < h_hs->size; h_j++){\
 			h_element = at_sized(*h_hs,h_j,(h).pair_size);\
 			(c);\
@@ -31,6 +31,7 @@ Always be consistent with your data.
 #include "linked_list.h"
 	...
 */
+// To allocate the nodes from a node pool instead of malloc, see "node_pool.h"
 #ifndef LINKED_LIST_FREE_NODE
 #define LINKED_LIST_FREE_NODE(n)
 #endif
@@ -59,6 +60,7 @@ Always be consistent with your data.
 #define linked_list_previous(a) ((typeof((a)))(a)->previous)
 
 // Adds node (b) at the end of singly or doubly linked list (a)
+// This walks through the whole list, to add many nodes use a queue instead (see queue.h)
 // CAUTION: Will loop infinitely if last node points to first
 #define linked_list_add_end(a,b) ({\
 	typeof((a)) ll_ptr = (a);\
@@ -69,9 +71,10 @@ Always be consistent with your data.
 // Adds node (b) at the start of doubly linked list (a)
 // CAUTION: Will loop infinitely if first node points last
 #define linked_list_add_start(a,b) ({\
-	typeof((a)) ll_ptr = (a);\
-	while(ll_ptr->next) { ll_ptr = (typeof((a))) ll_ptr->previous; }\
-	ll_ptr->previous = (b);\
+	typeof((a)) ll_ptr = (a), ll_new = (b);\
+	while(ll_ptr->previous) { ll_ptr = (typeof((a))) ll_ptr->previous; }\
+	ll_ptr->previous = ll_new;\
+	ll_new->next = ll_ptr;\
 })
 
 // Inserts node (b) after node (a)
@@ -0,0 +1,248 @@
+#ifndef CDS_MAPPED_HASHTABLE_H
+#define CDS_MAPPED_HASHTABLE_H
+
+// IMPORTANT! THIS HEADER DEPENDS ON "hashtable.h" AND ON POSIX (mmap)!
+
+// We need the hashtable functions
+#include "hashtable.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// A mapped hashtable is a hashtable saved in a file (with save_ht), and mapped back in memory read-only
+// Opening it only reads the header and the offsets of the hashsets (to check them), and allocates nothing:
+// the pages of the hashes and pairs are loaded by the OS when a lookup touches them,
+// and processes mapping the same file share them (only one copy in the page cache)
+// So opening even a huge hashtable is instant, compared to adding every pair again with add_ht
+//
+// The file has no pointers, only offsets from its start, so it can be mapped at any address:
+// - A header (mapped_ht_header_t)
+// - size+1 offsets: the pairs of hashset i are the pairs offsets[i] to offsets[i+1]-1
+// - The hashes of all the pairs, hashset after hashset
+// - The pairs themselves, in the same order
+//
+// The pairs are copied as they are, so they must be plain data:
+// any pointer in them (like a char* key) would point to nothing once mapped in another process
+// Use fixed size keys instead, with a hashing function that only reads the pair (hash_char_array_key_ht, hash_u64_key_ht...)
+// The file can only be opened on a machine with the same byte order and the same size_t as the one that saved it
+// To change a mapped hashtable, copy it to a hashtable_t first: build_ht(&ht,(void*)mht.pairs,mht.count)
+/* EXAMPLE:
+
+typedef struct{
+	char key[32]; // Name
+	unsigned int age;
+} person_pair_t;
+
+--- Process that builds the hashtable ---
+hashtable_t ht = create_ht(hash_char_array_key_ht,16,sizeof(person_pair_t));
+build_ht(&ht,people,count);
+if(save_ht(&ht,"people.ht") == -1) printf("Failed to save the hashtable!\n");
+
+--- Any other process ---
+mapped_ht_t people;
+if(open_mapped_ht(&people,"people.ht",hash_char_array_key_ht,person_pair_t) == -1) printf("Failed to open the hashtable!\n");
+person_pair_t person = (person_pair_t){"Bob"}, found_person;
+size_t result;
+find_mapped_ht(people, person, !strcmp(h_element.key,h_target.key), found_person, result);
+close_mapped_ht(&people);
+
+*/
+
+// First bytes of every mapped hashtable file
+#define MAPPED_HT_MAGIC 0x54484443 // "CDHT" in little endian, reads differently with another byte order
+#define MAPPED_HT_VERSION 1
+
+// Alignment of the pairs in the file (and in memory once mapped)
+#ifndef MAPPED_HT_ALIGN
+#define MAPPED_HT_ALIGN 64
+#endif
+
+// The header at the start of a mapped hashtable file
+typedef struct {
+	uint32_t magic; // Always MAPPED_HT_MAGIC
+	uint32_t version; // Always MAPPED_HT_VERSION
+	uint64_t hash_size; // sizeof(size_t) of the machine that saved it
+	uint64_t pair_size; // Size of the key/value pairs, in bytes
+	uint64_t size; // Amount of hashsets (a power of two)
+	uint64_t count; // Amount of pairs
+	uint64_t offsets_start; // Where the offsets of the hashsets are in the file
+	uint64_t hashes_start; // Where the hashes are in the file
+	uint64_t pairs_start; // Where the pairs are in the file
+} mapped_ht_header_t;
+
+// A hashtable mapped from a file, read-only
+typedef struct {
+	const char* data; // Start of the mapped file
+	size_t length; // Length of the mapped file, in bytes
+	size_t (*hashing_func)(size_t,void*); // The hashing function, must be the one the hashtable was saved with
+	size_t size; // Amount of hashsets
+	size_t count; // Amount of pairs
+	size_t pair_size; // Size of the key/value pairs, in bytes
+	const uint64_t* offsets; // Index of the first pair of each hashset (size+1 of them)
+	const size_t* hashes; // Hash of each pair
+	const char* pairs; // The pairs
+} mapped_ht_t;
+
+// Round x up to a multiple of a (a power of two)
+#define align_mapped_ht(x,a) (((x)+(a)-1) & ~(uint64_t)((a)-1))
+
+// Write the padding bytes needed to get from offset from to offset to in a file
+int pad_mapped_ht(FILE* file, uint64_t from, uint64_t to){
+	static const char zeros[MAPPED_HT_ALIGN];
+	return fwrite(zeros,1,to-from,file) == to-from ? 0 : -1;
+}
+
+// Save a hashtable in a file at path, that can then be opened with open_mapped_ht
+// The hashtable must have been setup, and an incremental rehash in progress is finished first
+// Returns 0 on success, -1 on failure (like the POSIX functions it uses, check errno to know why)
+int save_ht(hashtable_t* ht, const char* path){
+	if(ht->arr == NULL || ht->size == 0) return -1;
+	rehash_step_ht(ht,~0);
+	mapped_ht_header_t header = (mapped_ht_header_t){MAPPED_HT_MAGIC,MAPPED_HT_VERSION,sizeof(size_t),ht->pair_size,ht->size};
+	for(size_t i = 0; i < ht->size; i++) header.count += at(*ht,i).size;
+	header.offsets_start = align_mapped_ht(sizeof(mapped_ht_header_t),8);
+	header.hashes_start = header.offsets_start+sizeof(uint64_t)*(header.size+1);
+	header.pairs_start = align_mapped_ht(header.hashes_start+sizeof(size_t)*header.count,MAPPED_HT_ALIGN);
+
+	FILE* file = fopen(path,"wb");
+	if(file == NULL) return -1;
+	int failed = fwrite(&header,sizeof(header),1,file) != 1;
+	failed |= pad_mapped_ht(file,sizeof(header),header.offsets_start);
+	uint64_t offset = 0;
+	for(size_t i = 0; i <= ht->size && !failed; i++){
+		failed |= fwrite(&offset,sizeof(offset),1,file) != 1;
+		if(i < ht->size) offset += at(*ht,i).size;
+	}
+	for(size_t i = 0; i < ht->size && !failed; i++){
+		hashset_t* hs = &at(*ht,i);
+		if(hs->size) failed |= fwrite(hs->hashes,sizeof(size_t),hs->size,file) != hs->size;
+	}
+	failed |= pad_mapped_ht(file,header.hashes_start+sizeof(size_t)*header.count,header.pairs_start);
+	for(size_t i = 0; i < ht->size && !failed; i++){
+		hashset_t* hs = &at(*ht,i);
+		if(hs->size) failed |= fwrite(hs->arr,ht->pair_size,hs->size,file) != hs->size;
+	}
+	failed |= fclose(file) != 0;
+	return failed ? -1 : 0;
+}
+
+// Map the hashtable saved in the file at path, read-only
+// h is the hashing function the hashtable was saved with (it is checked against the first pair)
+// The macro takes the type of the key/value pairs, the function takes their size:
+// it must be the size of the pairs in the file, since the lookups copy whole pairs out of it
+// Returns 0 on success, -1 if the file can't be mapped or is not a valid hashtable file
+#define open_mapped_ht(m,path,h,t) open_mapped_ht_ex((m),(path),(h),sizeof(t))
+int open_mapped_ht_ex(mapped_ht_t* mht, const char* path, size_t (*h)(size_t,void*), size_t pair_size){
+	*mht = (mapped_ht_t){NULL};
+	int fd = open(path,O_RDONLY);
+	if(fd == -1) return -1;
+	struct stat st;
+	if(fstat(fd,&st) == -1 || (size_t)st.st_size < sizeof(mapped_ht_header_t)){
+		close(fd);
+		return -1;
+	}
+	void* data = mmap(NULL,st.st_size,PROT_READ,MAP_SHARED,fd,0);
+	close(fd); // The mapping stays valid without the file descriptor
+	if(data == MAP_FAILED) return -1;
+	mht->data = data;
+	mht->length = st.st_size;
+
+	// The file may be corrupted (or not a hashtable at all), so the sizes and positions of the header are checked
+	// without overflows, and must fit in the file, in order
+	const mapped_ht_header_t* header = data;
+	uint64_t offsets_end, hashes_end, pairs_end;
+	int valid = header->magic == MAPPED_HT_MAGIC && header->version == MAPPED_HT_VERSION
+		&& header->hash_size == sizeof(size_t) && header->pair_size && header->pair_size == pair_size && header->size
+		&& (header->size & (header->size-1)) == 0
+		&& header->offsets_start >= sizeof(mapped_ht_header_t) && header->offsets_start%sizeof(uint64_t) == 0
+		&& header->hashes_start%sizeof(size_t) == 0 && header->pairs_start%MAPPED_HT_ALIGN == 0
+		&& !__builtin_mul_overflow(header->size+1,sizeof(uint64_t),&offsets_end)
+		&& !__builtin_add_overflow(offsets_end,header->offsets_start,&offsets_end)
+		&& offsets_end <= header->hashes_start
+		&& !__builtin_mul_overflow(header->count,sizeof(size_t),&hashes_end)
+		&& !__builtin_add_overflow(hashes_end,header->hashes_start,&hashes_end)
+		&& hashes_end <= header->pairs_start
+		&& !__builtin_mul_overflow(header->count,header->pair_size,&pairs_end)
+		&& !__builtin_add_overflow(pairs_end,header->pairs_start,&pairs_end)
+		&& pairs_end == mht->length;
+	if(valid){
+		mht->hashing_func = h;
+		mht->size = header->size;
+		mht->count = header->count;
+		mht->pair_size = header->pair_size;
+		mht->offsets = (const uint64_t*)(mht->data+header->offsets_start);
+		mht->hashes = (const size_t*)(mht->data+header->hashes_start);
+		mht->pairs = mht->data+header->pairs_start;
+		// The lookups read the pairs between two offsets, so the offsets must go from 0 to count without decreasing
+		// (then none of them is bigger than count)
+		valid = mht->offsets[0] == 0 && mht->offsets[mht->size] == mht->count;
+		for(size_t i = 0; i < mht->size && valid; i++) valid = mht->offsets[i] <= mht->offsets[i+1];
+		// A different hashing function would make every lookup fail, so check it on the first pair
+		if(valid && mht->count) valid = h && h(~(size_t)0,(void*)mht->pairs) == mht->hashes[0];
+	}
+	if(!valid){
+		munmap(data,st.st_size);
+		*mht = (mapped_ht_t){NULL};
+		return -1;
+	}
+	return 0;
+}
+
+// Unmap a mapped hashtable
+// The pointers to its pairs become invalid
+void close_mapped_ht(mapped_ht_t* mht){
+	if(mht->data) munmap((void*)mht->data,mht->length);
+	*mht = (mapped_ht_t){NULL};
+}
+
+// Get a pointer to a pair of a mapped hashtable (pair i of the file)
+#define at_mapped_ht(h,i) ((h).pairs+(size_t)(i)*(h).pair_size)
+
+// Find a key/value pair in a mapped hashtable, with a pointer to it (in the mapped file) as the result
+// Same arguments as find_ptr_ht, the fourth one must be a pointer to a const type (the pairs are read-only)
+// The pointer is valid until the mapped hashtable is closed
+// Nothing is found if the pairs of the file are smaller than the type of (e)
+#define find_ptr_mapped_ht(h,e,c,p) ({\
+	typeof((e)) h_target = (e);\
+	typeof((e)) h_element;\
+	(p) = NULL;\
+	if((h).data && (h).size && (h).pair_size >= sizeof(h_target)){\
+		size_t h_hash = (h).hashing_func(~(size_t)0,&h_target);\
+		size_t h_first = (h).offsets[reduce_hash_ht(h_hash,(h).size)];\
+		size_t h_count = (h).offsets[reduce_hash_ht(h_hash,(h).size)+1]-h_first;\
+		for(size_t h_i = 0; (h_i = find_hash_hs((h).hashes+h_first,h_i,h_count,h_hash)) < h_count; h_i++){\
+			memcpy(&h_element,at_mapped_ht((h),h_first+h_i),sizeof(h_element));\
+			if((c)){\
+				(p) = (typeof((p))) at_mapped_ht((h),h_first+h_i);\
+				break;\
+			}\
+		}\
+	}\
+})
+
+// Find a key/value pair in a mapped hashtable
+// Same arguments as find_ht, except the fifth one is the index of the pair in the whole file (is equals to -1 when its not found)
+#define find_mapped_ht(h,e,c,s,r) ({\
+	const typeof((e))* h_found;\
+	find_ptr_mapped_ht((h),(e),(c),h_found);\
+	(r) = h_found ? (size_t)((const char*)h_found-(h).pairs)/(h).pair_size : ~(size_t)0;\
+	if(h_found) (s) = *(typeof((s))*) h_found;\
+})
+
+// Parse through all the items of a mapped hashtable
+// Second arg is the code to be executed for each key/value pair
+// Use these local variables as references:
+/*
+- h_element -> const void*, is a pointer to the start of the element you are parsing (in the mapped file)
+- h_i -> size_t, is the index of the element in the whole file
+*/
+#define parse_mapped_ht(h,c) ({\
+	const void* h_element;\
+	for(size_t h_i = 0; h_i < (h).count; h_i++){\
+		h_element = at_mapped_ht((h),h_i);\
+		(c);\
+	}\
+})
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef CDS_NODE_POOL_H
+#define CDS_NODE_POOL_H
+
+#include <stddef.h>
+#include <string.h>
+
+// A node pool allocates the nodes of linked lists and binary trees (or any other fixed size structure)
+// Instead of one malloc per node, nodes are taken from slabs of many nodes,
+// and the nodes given back are kept in a list of free nodes, to be used again first
+// So nodes are close together in memory, and creating or removing one is only a few instructions
+//
+// A whole list or tree can then be freed in one call, by resetting (or freeing) its pool,
+// instead of walking through it with free_singly_linked_list or free_binary_tree
+/* EXAMPLE:
+
+typedef singly_linked_list_with(int number) number_list_t;
+
+node_pool_t pool = create_node_pool(number_list_t);
+number_list_t* first = new_singly_list_node(&pool,number_list_t,0);
+for(int i = 1; i < 1000; i++) linked_list_insert_next(first,new_singly_list_node(&pool,number_list_t,i));
+--- Use the list... ---
+reset_node_pool(&pool); // All the nodes are freed, the pool can be used again for another list
+free_node_pool(&pool); // Give the memory back
+
+*/
+// To remove single nodes with the macros of linked_list.h or binary_tree.h, make them give the nodes back to the pool:
+/* EXAMPLE:
+
+#include "node_pool.h"
+#define LINKED_LIST_FREE_NODE(n) NODE_POOL_FREE_NODE((n))
+#include "linked_list.h"
+
+current_node_pool = &pool;
+
+*/
+// Define NODE_POOL_THREAD_LOCAL before including this header to have one current_node_pool per thread
+// (a node pool itself must only be used by one thread at a time)
+
+// You can overwrite these macros, to allocate the slabs of the pools
+#ifndef NODE_POOL_ALLOC
+#include <stdlib.h>
+#define NODE_POOL_ALLOC(sz) malloc((sz))
+#endif
+
+#ifndef NODE_POOL_FREE
+#include <stdlib.h>
+#define NODE_POOL_FREE(ptr) free((ptr))
+#endif
+
+// Default amount of nodes in a slab
+#ifndef NODE_POOL_SLAB_NODES
+#define NODE_POOL_SLAB_NODES 256
+#endif
+
+// A slab of nodes, the nodes are right after it
+typedef struct node_slab_t{
+	struct node_slab_t* next;
+} node_slab_t;
+
+// Get node i of a slab
+#define node_slab_at(p,s,i) ((char*)(s)+node_slab_header()+(i)*(p)->node_size)
+#define node_slab_header() ((sizeof(node_slab_t)+_Alignof(max_align_t)-1) & ~(_Alignof(max_align_t)-1))
+
+// The node pool structure
+typedef struct {
+	node_slab_t* first; // First slab (NULL when no node was created yet)
+	node_slab_t* current; // Slab the new nodes are taken from
+	size_t used; // Nodes used in the current slab
+	void* free_nodes; // Nodes given back, each one pointing to the next
+	size_t node_size; // Size of a node, in bytes
+	size_t slab_nodes; // Amount of nodes in a slab
+	size_t count; // Amount of nodes in use
+} node_pool_t;
+
+// Create a node pool for nodes of type t, with nothing in it
+// A node must be able to hold a pointer (any linked list or binary tree node can)
+#define create_node_pool(t) (node_pool_t){NULL,NULL,0,NULL,sizeof(t) > sizeof(void*) ? sizeof(t) : sizeof(void*),NODE_POOL_SLAB_NODES,0}
+
+// Allocate a node from the pool, its content is undefined
+// Returns NULL if there is no memory left
+void* alloc_node_pool(node_pool_t* p){
+	void* node = p->free_nodes;
+	if(node){
+		p->free_nodes = *(void**)node;
+		p->count++;
+		return node;
+	}
+	if(p->current == NULL || p->used == p->slab_nodes){
+		// Use the next slab if the pool was reset, else add one
+		node_slab_t* next = p->current ? p->current->next : p->first;
+		if(next == NULL){
+			next = NODE_POOL_ALLOC(node_slab_header()+p->slab_nodes*p->node_size);
+			if(next == NULL) return NULL;
+			next->next = NULL;
+			if(p->current) p->current->next = next;
+			else p->first = next;
+		}
+		p->current = next;
+		p->used = 0;
+	}
+	p->count++;
+	return node_slab_at(p,p->current,p->used++);
+}
+
+// Give a node back to the pool, it will be used by the next node created
+void dealloc_node_pool(node_pool_t* p, void* node){
+	if(node == NULL) return;
+	*(void**)node = p->free_nodes;
+	p->free_nodes = node;
+	p->count--;
+}
+
+// Free every node of the pool at once (every list or tree made of them)
+// The slabs are kept, and used again by the next nodes created
+void reset_node_pool(node_pool_t* p){
+	p->current = p->first;
+	p->used = 0;
+	p->free_nodes = NULL;
+	p->count = 0;
+}
+
+// Free every node of the pool, and give its slabs back
+void free_node_pool(node_pool_t* p){
+	while(p->first){
+		node_slab_t* next = p->first->next;
+		NODE_POOL_FREE(p->first);
+		p->first = next;
+	}
+	reset_node_pool(p);
+}
+
+// Create a node of type t from the pool (as a pointer), with the other arguments as values for its members
+// Like create_singly_list_node, create_doubly_list_node and create_binary_tree_node, the pointers of the node are set to NULL
+// Returns NULL if there is no memory left (or if the pool was created for a smaller type)
+#define new_node_pool(p,t,...) ({\
+	node_pool_t* np_pool = (p);\
+	t* np_node = sizeof(t) <= np_pool->node_size ? alloc_node_pool(np_pool) : NULL;\
+	if(np_node) *np_node = (t){__VA_ARGS__};\
+	np_node;\
+})
+#define new_singly_list_node(p,t,...) new_node_pool((p),t,NULL,##__VA_ARGS__)
+#define new_doubly_list_node(p,t,...) new_node_pool((p),t,NULL,NULL,##__VA_ARGS__)
+#define new_binary_tree_node(p,t,...) new_node_pool((p),t,NULL,NULL,##__VA_ARGS__)
+
+#ifdef NODE_POOL_THREAD_LOCAL
+#define NODE_POOL_STORAGE _Thread_local
+#else
+#define NODE_POOL_STORAGE
+#endif
+
+// The node pool used by NODE_POOL_FREE_NODE
+NODE_POOL_STORAGE node_pool_t* current_node_pool = NULL;
+
+// Hook to define LINKED_LIST_FREE_NODE or BINARY_TREE_FREE_NODE as
+#define NODE_POOL_FREE_NODE(n) dealloc_node_pool(current_node_pool,(n))
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef CDS_QUEUE_H
+#define CDS_QUEUE_H
+
+// IMPORTANT! THIS HEADER DEPENDS ON "linked_list.h"!
+
+// We need the linked list macros
+#include "linked_list.h"
+#include <stddef.h>
+
+// A queue is a handle to a singly or doubly linked list (see linked_list.h), that keeps track of:
+// - head : the first node of the list
+// - tail : the last node of the list
+// - count : the amount of nodes in the list
+// So adding a node at the start or the end of the list, or removing the first one, is done in O(1),
+// without walking through the list like linked_list_add_end does
+// (and for doubly linked lists, removing the last node or any other one too)
+//
+// The queue doesn't allocate anything, the nodes are created by you (with malloc, or a node pool, see node_pool.h)
+// A node can only be in one queue at a time, and should only be linked or unlinked with the macros below
+// The macros working with singly linked lists have "singly" in their name, the others have "doubly"
+// Always use the ones matching the type of the nodes, the doubly ones also keep the ->previous pointers right
+/* EXAMPLE:
+
+typedef singly_linked_list_with(int id) job_t;
+typedef queue_of(job_t) job_queue_t;
+
+job_queue_t jobs = create_queue();
+job_t* job = malloc(sizeof(job_t));
+*job = (job_t) create_singly_list_node(42);
+push_back_singly_queue(jobs,job);
+--- Later ---
+job_t* next_job = pop_front_singly_queue(jobs); // NULL if there are no jobs left
+
+*/
+
+// Template to create a queue type for nodes of type t
+// Example: typedef queue_of(number_list_t) number_queue_t;
+#define queue_of(t) struct { t *head, *tail; size_t count; }
+
+// Create an empty queue
+#define create_queue() {NULL,NULL,0}
+
+// Free every node of the queue (with LINKED_LIST_FREE_NODE) and empty it
+#define free_queue(q) ({\
+	free_singly_linked_list((q).head);\
+	(q).tail = NULL;\
+	(q).count = 0;\
+})
+
+// Parse through every node of the queue, from head to tail
+// Second arg is the code to be executed for each node
+// Use these local variables as references:
+/*
+- q_node -> pointer to the node you are parsing
+- q_i -> size_t, index of the node in the queue
+*/
+// The node being parsed can't be removed, since its ->next pointer is used after the code is executed
+#define parse_queue(q,c) ({\
+	typeof((q).head) q_node = (q).head;\
+	for(size_t q_i = 0; q_node; q_i++, q_node = (typeof((q).head)) q_node->next){\
+		(c);\
+	}\
+})
+
+// Add node (n) at the end of the queue
+#define push_back_singly_queue(q,n) ({\
+	typeof((q).head) q_push = (n);\
+	q_push->next = NULL;\
+	if((q).tail) (q).tail->next = q_push;\
+	else (q).head = q_push;\
+	(q).tail = q_push;\
+	(q).count++;\
+})
+#define push_back_doubly_queue(q,n) ({\
+	typeof((q).head) q_push_d = (n);\
+	q_push_d->previous = (q).tail;\
+	push_back_singly_queue((q),q_push_d);\
+})
+
+// Add node (n) at the start of the queue
+#define push_front_singly_queue(q,n) ({\
+	typeof((q).head) q_push = (n);\
+	q_push->next = (q).head;\
+	if((q).head == NULL) (q).tail = q_push;\
+	(q).head = q_push;\
+	(q).count++;\
+})
+#define push_front_doubly_queue(q,n) ({\
+	typeof((q).head) q_push_d = (n);\
+	q_push_d->previous = NULL;\
+	if((q).head) (q).head->previous = q_push_d;\
+	push_front_singly_queue((q),q_push_d);\
+})
+
+// Remove the first node of the queue, and get it (NULL if the queue is empty)
+// The node is not freed, its pointers are set to NULL
+#define pop_front_singly_queue(q) ({\
+	typeof((q).head) q_pop = (q).head;\
+	if(q_pop){\
+		(q).head = (typeof((q).head)) q_pop->next;\
+		if((q).head == NULL) (q).tail = NULL;\
+		q_pop->next = NULL;\
+		(q).count--;\
+	}\
+	q_pop;\
+})
+#define pop_front_doubly_queue(q) ({\
+	typeof((q).head) q_pop_d = pop_front_singly_queue((q));\
+	if((q).head) (q).head->previous = NULL;\
+	q_pop_d;\
+})
+
+// Remove the last node of the queue, and get it (NULL if the queue is empty)
+// Only for doubly linked lists, a singly linked list would have to be walked through to find the new tail
+#define pop_back_doubly_queue(q) ({\
+	typeof((q).head) q_pop = (q).tail;\
+	if(q_pop){\
+		(q).tail = (typeof((q).head)) q_pop->previous;\
+		if((q).tail) (q).tail->next = NULL;\
+		else (q).head = NULL;\
+		q_pop->previous = NULL;\
+		(q).count--;\
+	}\
+	q_pop;\
+})
+
+// Remove node (n) from the queue, wherever it is in it
+// Only for doubly linked lists, (n) must be in the queue
+#define remove_doubly_queue(q,n) ({\
+	typeof((q).head) q_remove = (n);\
+	if(q_remove->previous) ((typeof((q).head)) q_remove->previous)->next = q_remove->next;\
+	else (q).head = (typeof((q).head)) q_remove->next;\
+	if(q_remove->next) ((typeof((q).head)) q_remove->next)->previous = q_remove->previous;\
+	else (q).tail = (typeof((q).head)) q_remove->previous;\
+	q_remove->next = q_remove->previous = NULL;\
+	(q).count--;\
+})
+
+// Move every node of queue (o) into queue (q), right after node (p) of (q)
+// If (p) is NULL, they are moved at the start of (q)
+// (o) is left empty, (p) must be in (q)
+#define splice_singly_queue(q,p,o) ({\
+	typeof((q).head) q_after = (p);\
+	if((o).head){\
+		typeof((q).head) q_next = q_after ? (typeof((q).head)) q_after->next : (q).head;\
+		(o).tail->next = q_next;\
+		if(q_after) q_after->next = (o).head;\
+		else (q).head = (o).head;\
+		if(q_next == NULL) (q).tail = (o).tail;\
+		(q).count += (o).count;\
+		(o).head = (o).tail = NULL;\
+		(o).count = 0;\
+	}\
+})
+#define splice_doubly_queue(q,p,o) ({\
+	typeof((q).head) q_after_d = (p);\
+	if((o).head){\
+		typeof((q).head) q_next_d = q_after_d ? (typeof((q).head)) q_after_d->next : (q).head;\
+		(o).head->previous = q_after_d;\
+		if(q_next_d) q_next_d->previous = (o).tail;\
+		splice_singly_queue((q),q_after_d,(o));\
+	}\
+})
+
+// Move every node of queue (o) at the end of queue (q), (o) is left empty
+#define concat_singly_queue(q,o) splice_singly_queue((q),(q).tail,(o))
+#define concat_doubly_queue(q,o) splice_doubly_queue((q),(q).tail,(o))
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef CDS_UNROLLED_LIST_H
+#define CDS_UNROLLED_LIST_H
+
+#include <stddef.h>
+#include <string.h>
+
+// An unrolled linked list is a linked list where each node holds an array of elements instead of a single one
+// Walking through a normal linked list loads one node (one cache line) per element, and can only
+// load the next node once the current one is loaded. With an unrolled list, each node is loaded once for
+// a whole array of elements, which are next to each other in memory
+//
+// A full node is split in two halves when an element is inserted in it, and a node less than half full
+// takes the elements of the next node when they fit, so the nodes stay mostly full
+// Finding the element at an index, inserting and removing only walk through the nodes, not through every element
+//
+// Here is how it looks like with 4 elements per node:
+//
+// 	head                      tail
+// 	[1 2 3 -] -> [4 5 - -] -> [6 7 8 9]
+//
+// Unlike linked_list.h, the nodes are allocated by the list, with the macros below
+/* EXAMPLE:
+
+typedef unrolled_list_of(int) int_list_t;
+
+int_list_t list = create_unrolled_list();
+for(int i = 0; i < 100; i++) push_back_unrolled_list(list,i);
+insert_unrolled_list(list,50,-1); // -1 is now at index 50
+parse_unrolled_list(list,({
+	printf("%d\n",ul_element);
+}));
+free_unrolled_list(list);
+
+*/
+
+// Size of a node, in bytes (two cache lines)
+// The amount of elements in a node is computed from it, and is at least 1
+#ifndef UNROLLED_LIST_NODE_SIZE
+#define UNROLLED_LIST_NODE_SIZE 128
+#endif
+
+// You can overwrite these macros, to allocate the nodes
+#ifndef UNROLLED_LIST_ALLOC
+#include <stdlib.h>
+#define UNROLLED_LIST_ALLOC(sz) malloc((sz))
+#endif
+
+#ifndef UNROLLED_LIST_FREE
+#include <stdlib.h>
+#define UNROLLED_LIST_FREE(ptr) free((ptr))
+#endif
+
+// Amount of elements of type t in a node
+#define unrolled_list_node_capacity(t) ((UNROLLED_LIST_NODE_SIZE-2*sizeof(void*)) > sizeof(t) ? (UNROLLED_LIST_NODE_SIZE-2*sizeof(void*))/sizeof(t) : 1)
+
+// Template to create an unrolled list type storing elements of type t
+// The list itself is a handle to the first and last nodes, with the amount of elements in the list
+// Example: typedef unrolled_list_of(int) int_list_t;
+#define unrolled_list_of(t) struct { struct { void* next; size_t count; t items[unrolled_list_node_capacity(t)]; } *head, *tail; size_t size; }
+
+// Create an empty unrolled list
+#define create_unrolled_list() {NULL,NULL,0}
+
+// Get the amount of elements a node of the list can hold
+#define capacity_unrolled_list(l) (sizeof((l).head->items)/sizeof((l).head->items[0]))
+
+// Allocate an empty node for list (l)
+#define new_node_unrolled_list(l) ({\
+	typeof((l).head) ul_new = UNROLLED_LIST_ALLOC(sizeof(*(l).head));\
+	ul_new->next = NULL;\
+	ul_new->count = 0;\
+	ul_new;\
+})
+
+// Free / clear an unrolled list
+#define free_unrolled_list(l) ({\
+	typeof((l).head) ul_free = (l).head;\
+	while(ul_free){\
+		typeof((l).head) ul_next = ul_free->next;\
+		UNROLLED_LIST_FREE(ul_free);\
+		ul_free = ul_next;\
+	}\
+	(l).head = (l).tail = NULL;\
+	(l).size = 0;\
+})
+
+// Find the node holding the element at index (i) of the list
+// Sets (n) to the node, (j) to the index of the element in the node and (p) to the node before it (NULL for the first node)
+// If (i) is the size of the list, (n) is the last node and (j) its count
+#define locate_unrolled_list(l,i,n,j,p) ({\
+	size_t ul_index = (i);\
+	(p) = NULL;\
+	(n) = (l).head;\
+	while((n) && (n)->next && ul_index >= (n)->count){\
+		ul_index -= (n)->count;\
+		(p) = (n);\
+		(n) = (n)->next;\
+	}\
+	(j) = ul_index;\
+})
+
+// Get a pointer to the element at index (i) of the list (NULL if (i) is out of the list)
+#define at_unrolled_list(l,i) ({\
+	typeof((l).head) ul_at_node, ul_at_prev;\
+	size_t ul_at_i = (i), ul_at_j;\
+	locate_unrolled_list((l),ul_at_i,ul_at_node,ul_at_j,ul_at_prev);\
+	(void)ul_at_prev;\
+	(typeof(&(l).head->items[0]))(ul_at_i < (l).size ? &ul_at_node->items[ul_at_j] : NULL);\
+})
+
+// Add element (e) at the end of the list
+#define push_back_unrolled_list(l,e) ({\
+	if((l).tail == NULL || (l).tail->count == capacity_unrolled_list((l))){\
+		typeof((l).head) ul_node = new_node_unrolled_list((l));\
+		if((l).tail) (l).tail->next = ul_node;\
+		else (l).head = ul_node;\
+		(l).tail = ul_node;\
+	}\
+	(l).tail->items[(l).tail->count++] = (e);\
+	(l).size++;\
+})
+
+// Insert element (e) at index (i) of the list, the elements after it are shifted to the right
+// (i) can be the size of the list, to add the element at the end
+// When the node where (e) goes is full, half of its elements are moved to a new node after it
+#define insert_unrolled_list(l,i,e) ({\
+	size_t ul_i = (i);\
+	if(ul_i >= (l).size || (l).head == NULL) push_back_unrolled_list((l),(e));\
+	else{\
+		typeof((l).head) ul_node, ul_prev;\
+		size_t ul_j;\
+		locate_unrolled_list((l),ul_i,ul_node,ul_j,ul_prev);\
+		(void)ul_prev;\
+		size_t ul_cap = capacity_unrolled_list((l));\
+		if(ul_node->count == ul_cap){\
+			typeof((l).head) ul_split = new_node_unrolled_list((l));\
+			size_t ul_half = ul_cap/2;\
+			memcpy(ul_split->items,ul_node->items+ul_half,sizeof(ul_node->items[0])*(ul_cap-ul_half));\
+			ul_split->count = ul_cap-ul_half;\
+			ul_node->count = ul_half;\
+			ul_split->next = ul_node->next;\
+			ul_node->next = ul_split;\
+			if((l).tail == ul_node) (l).tail = ul_split;\
+			if(ul_j > ul_half){\
+				ul_j -= ul_half;\
+				ul_node = ul_split;\
+			}\
+		}\
+		memmove(ul_node->items+ul_j+1,ul_node->items+ul_j,sizeof(ul_node->items[0])*(ul_node->count-ul_j));\
+		ul_node->items[ul_j] = (e);\
+		ul_node->count++;\
+		(l).size++;\
+	}\
+})
+
+// Add element (e) at the start of the list
+#define push_front_unrolled_list(l,e) insert_unrolled_list((l),0,(e))
+
+// Remove the element at index (i) of the list, the elements after it are shifted to the left
+// When the node it was in gets less than half full, the elements of the next node are moved in it if they fit
+#define remove_unrolled_list(l,i) ({\
+	size_t ul_i = (i);\
+	if(ul_i < (l).size){\
+		typeof((l).head) ul_node, ul_prev;\
+		size_t ul_j;\
+		locate_unrolled_list((l),ul_i,ul_node,ul_j,ul_prev);\
+		size_t ul_cap = capacity_unrolled_list((l));\
+		memmove(ul_node->items+ul_j,ul_node->items+ul_j+1,sizeof(ul_node->items[0])*(ul_node->count-ul_j-1));\
+		ul_node->count--;\
+		(l).size--;\
+		typeof((l).head) ul_next = ul_node->next;\
+		if(ul_node->count == 0){\
+			if(ul_prev) ul_prev->next = ul_next;\
+			else (l).head = ul_next;\
+			if((l).tail == ul_node) (l).tail = ul_prev;\
+			UNROLLED_LIST_FREE(ul_node);\
+		}\
+		else if(ul_node->count < ul_cap/2 && ul_next && ul_node->count+ul_next->count <= ul_cap){\
+			memcpy(ul_node->items+ul_node->count,ul_next->items,sizeof(ul_node->items[0])*ul_next->count);\
+			ul_node->count += ul_next->count;\
+			ul_node->next = ul_next->next;\
+			if((l).tail == ul_next) (l).tail = ul_node;\
+			UNROLLED_LIST_FREE(ul_next);\
+		}\
+	}\
+})
+
+// Parse through every element of the list, from the start to the end
+// Second arg is the code to be executed for each element
+// Use these local variables as references:
+/*
+- ul_element -> the element you are parsing (a copy of it)
+- ul_ptr -> a pointer to the element you are parsing (to change it)
+- ul_i -> size_t, index of the element in the list
+*/
+// Don't insert or remove elements while parsing the list
+#define parse_unrolled_list(l,c) ({\
+	size_t ul_i = 0;\
+	for(typeof((l).head) ul_node = (l).head; ul_node; ul_node = ul_node->next){\
+		for(size_t ul_j = 0; ul_j < ul_node->count; ul_j++, ul_i++){\
+			typeof(ul_node->items[0]) ul_element = ul_node->items[ul_j];\
+			typeof(&ul_node->items[0]) ul_ptr = &ul_node->items[ul_j];\
+			(void)ul_element;\
+			(void)ul_ptr;\
+			(c);\
+		}\
+	}\
+})
+
+// Find the first element of the list for which condition (c) is true (use ul_element in it)
+// (r) is set to its index, or to ~0 (-1) if there is none
+#define find_unrolled_list(l,c,r) ({\
+	(r) = ~0;\
+	size_t ul_i = 0;\
+	for(typeof((l).head) ul_node = (l).head; ul_node && (r) == ~0; ul_node = ul_node->next){\
+		for(size_t ul_j = 0; ul_j < ul_node->count; ul_j++, ul_i++){\
+			typeof(ul_node->items[0]) ul_element = ul_node->items[ul_j];\
+			if((c)){\
+				(r) = ul_i;\
+				break;\
+			}\
+		}\
+	}\
+})
+
+#endif
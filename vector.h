@@ -2,6 +2,7 @@
 #define CDS_VECTOR_H
 
 #include <stdio.h>
+#include <string.h>
 
 // Vector structure macros
 // A vector structure must have these 2 members:
@@ -31,7 +32,8 @@
 #define create_vector() {NULL,0}
 
 // Clear / free a vector
-#define free_vector(v) ({ if((v).size && (v).arr) VECTOR_FREE((v).arr); (v).arr = NULL; (v).size = 0; })
+// Popping never gives memory back, so arr can still be allocated when size is 0
+#define free_vector(v) ({ if((v).arr) VECTOR_FREE((v).arr); (v).arr = NULL; (v).size = 0; })
 
 // Push an element e at the back of vector v
 #define push_back(v, e) ({\
@@ -45,9 +47,78 @@
 	(v).arr = VECTOR_REALLOC((v).arr,(s)*++(v).size);\
 })
 
-// Allocate and "reserve" a new block of memory for n elements
-#define reserve_vector(v, n) ({\
-	(v).arr = VECTOR_REALLOC((v).arr,sizeof(typeof(e))*++(v).size);\
+// Capacity vectors
+// A capacity vector is a vector with a third member:
+// <type>* arr, <any int type> size, <any int type> capacity
+// Where capacity is the amount of elements arr has room for
+// Appending to it only calls VECTOR_REALLOC when the capacity is exceeded,
+// and the capacity then grows geometrically (see VECTOR_GROWTH)
+// Every other macro of this header works with it (at, pop_back, find_vector, parse_vector...)
+// but elements must be added with the _cap macros, push_back would shrink arr under the capacity
+// Like any vector, initialize it with create_vector() (capacity is then 0)
+/* EXAMPLE:
+typedef capacity_vector_with(int) int_cvector;
+int_cvector v = (int_cvector) create_vector();
+reserve_vector(v,1000);
+for(int i = 0; i < 1000; i++) push_back_cap(v,i); // No reallocation at all
+*/
+#define capacity_vector_with(type) struct { type* arr; size_t size; size_t capacity; }
+
+// New capacity of a capacity vector that is full
+// You can overwrite this macro with another (it must return more than c)
+#ifndef VECTOR_GROWTH
+#define VECTOR_GROWTH(c) ((c) < 8 ? 8 : (c)*2)
+#endif
+
+// Make sure capacity vector v has room for at least n elements of size s
+// Grows geometrically, so calling it before every append is amortized O(1)
+#define grow_vector_sized(v, n, s) ({\
+	if(!(v).arr || (v).capacity < (n)){\
+		typeof((v).capacity) v_cap = (v).arr ? (v).capacity : 0;\
+		v_cap = VECTOR_GROWTH(v_cap);\
+		if(v_cap < (n)) v_cap = (n);\
+		(v).arr = VECTOR_REALLOC((v).arr,(s)*v_cap);\
+		(v).capacity = v_cap;\
+	}\
+})
+
+// Allocate and "reserve" memory for n elements in capacity vector v
+// Does not change the size of the vector, only its capacity
+#define reserve_vector(v, n) reserve_vector_sized((v),(n),sizeof(*(v).arr))
+
+// Reserve memory for n elements in capacity vector v, with a specified type size
+#define reserve_vector_sized(v, n, s) ({\
+	if((n) && (!(v).arr || (v).capacity < (n))){\
+		(v).arr = VECTOR_REALLOC((v).arr,(s)*(n));\
+		(v).capacity = (n);\
+	}\
+})
+
+// Push an element e at the back of capacity vector v
+#define push_back_cap(v, e) ({\
+	grow_vector_sized((v),(v).size+1,sizeof(*(v).arr));\
+	(v).arr[(v).size++] = (e);\
+})
+
+// Add a new element to capacity vector v, but with a specified type size
+// Does not insert the newly added element in the array
+#define add_size_vector_cap(v, s) ({\
+	grow_vector_sized((v),(v).size+1,(s));\
+	(v).size++;\
+})
+
+// Give the unused capacity of capacity vector v back to the allocator
+#define shrink_to_fit(v) shrink_to_fit_sized((v),sizeof(*(v).arr))
+
+// Give the unused capacity back to the allocator, with a specified type size
+#define shrink_to_fit_sized(v, s) ({\
+	if((v).size){\
+		(v).arr = VECTOR_REALLOC((v).arr,(s)*(v).size);\
+		(v).capacity = (v).size;\
+	}else{\
+		free_vector((v));\
+		(v).capacity = 0;\
+	}\
 })
 
 // Get nth element of vector
@@ -60,32 +131,66 @@
 // Get last element of vector
 #define at_back(v) ((v).arr[(v).size-1])
 
+// Popping only changes the size of the vector, the memory is kept for the next elements
+// This is what lets capacity vectors use these macros too, and makes stack-like use
+// (push, pop, push, pop...) never call the allocator once the vector is big enough
+// Memory policy, when memory is given back to the allocator:
+// - pop_back, pop_at, truncate_vector: never
+// - trim_vector: only when VECTOR_SHOULD_TRIM says the capacity vector is mostly empty
+// - shrink_to_fit: always, down to the exact size of a capacity vector
+// - free_vector: always, all of it
+
 // Pop last element off the vector
 #define pop_back(v) ({\
-	if((v).size > 0)(v).arr = VECTOR_REALLOC((v).arr,sizeof(typeof(*(v).arr))*--(v).size);\
+	if((v).size > 0) --(v).size;\
 })
 
 // Pop last element off the vector with sized elements
 #define pop_back_sized(v,s) ({\
-	if((v).size > 0)(v).arr = VECTOR_REALLOC((v).arr,(s)*--(v).size);\
+	if((v).size > 0) --(v).size;\
 })
 
 // Pop nth element off the vector
-// Shifts all next elements by <- 1
-#define pop_at(v,n) ({\
-	for(int v_i = (n); v_i < (v).size-1; v_i++){\
-		(v).arr[v_i] = (v).arr[v_i+1];\
-	}\
-	if((v).size > 0)(v).arr = VECTOR_REALLOC((v).arr,sizeof(typeof(*(v).arr))*--(v).size);\
-})
+// Shifts all next elements by <- 1 (with a single memmove)
+#define pop_at(v,n) pop_at_sized((v),(n),sizeof(*(v).arr))
 
 // Pop nth element off the vector, with sized elements
-// Shifts all next elements by <- 1
+// Shifts all next elements by <- 1 (with a single memmove)
 #define pop_at_sized(v,n,s) ({\
-	for(int v_i = (n); v_i < (v).size-1; v_i++){\
-		*at_sized((v),v_i,(s)) = *at_sized((v),v_i+1,(s));\
+	typeof((v).size) v_n = (n);\
+	if(v_n < (v).size){\
+		memmove((char*)(v).arr+(s)*v_n,(char*)(v).arr+(s)*(v_n+1),(s)*((v).size-v_n-1));\
+		--(v).size;\
+	}\
+})
+
+// Remove all elements after the nth one, so that the vector has (at most) n elements
+#define truncate_vector(v,n) ({\
+	if((n) < (v).size) (v).size = (n);\
+})
+
+// Tells if a capacity vector uses so little of its capacity that trim_vector should shrink it
+// You can overwrite this macro with another
+#ifndef VECTOR_SHOULD_TRIM
+#define VECTOR_SHOULD_TRIM(size, capacity) ((size) < (capacity)/4)
+#endif
+
+// Give memory back from a capacity vector, only if VECTOR_SHOULD_TRIM agrees
+// The capacity is halved down to twice the size, so pushing right after does not reallocate
+// Call it at moments where it is cheap for you, like after processing a batch
+#define trim_vector(v) trim_vector_sized((v),sizeof(*(v).arr))
+
+// Give memory back from a capacity vector, with a specified type size
+#define trim_vector_sized(v,s) ({\
+	if((v).arr && VECTOR_SHOULD_TRIM((v).size,(v).capacity)){\
+		if((v).size){\
+			(v).capacity = (v).size*2;\
+			(v).arr = VECTOR_REALLOC((v).arr,(s)*(v).capacity);\
+		}else{\
+			free_vector((v));\
+			(v).capacity = 0;\
+		}\
 	}\
-	if((v).size > 0)(v).arr = VECTOR_REALLOC((v).arr,(s)*--(v).size);\
 })
 
 /*
@@ -111,12 +216,17 @@ printf("five is at index: %d\n",result);
 	}\
 })
 
+// Evaluate sorting condition c with v_a = x and v_b = y
+// Used by the sorting macros, v_a and v_b must be declared where it is used
+#define vector_cond_ab(c, x, y) ({ v_a = (x); v_b = (y); (c); })
+
 /*
 Sort the vector using condition c with elements v_a and v_b
-If condition is true, switch out two elements
-Else, just skip it
-Parse through the vector until everything is at the right place
-Very unefficient, worst case scenario O(n^2)
+If condition is true, v_a has to be after v_b in the sorted vector
+Else, they can stay in that order
+Introsort: quicksort (median of three), switching to heapsort if the partitions
+are too unbalanced, and to insertion sort for small partitions
+Worst case scenario O(n log n), not stable (equal elements may be reordered)
 Example of usage:
 
 struct int_vector v = (struct int_vector) create_vector();
@@ -125,6 +235,130 @@ sort_vector(v,v_a > v_b); // Sorts the array ascendingly
 -- Do something with the sorted vector --
 */
 #define sort_vector(v, c) ({\
+	typeof(*(v).arr) v_a, v_b, v_x;\
+	typeof((v).arr) v_arr = (v).arr;\
+	size_t v_stack[64][3], v_top = 0;\
+	size_t v_lo = 0, v_hi = (v).size, v_depth = 0;\
+	for(size_t v_n = v_hi; v_n > 1; v_n >>= 1) v_depth += 2;\
+	while(1){\
+		while(v_hi - v_lo > 16){\
+			if(v_depth == 0){\
+				/* Heapsort v_arr[v_lo..v_hi), build the heap then pop it */\
+				typeof((v).arr) v_h = v_arr+v_lo;\
+				size_t v_n = v_hi-v_lo;\
+				for(size_t v_t = v_n/2+v_n; v_t-- > 1;){\
+					size_t v_root = 0, v_end = v_t, v_child;\
+					if(v_t >= v_n){ v_root = v_t-v_n; v_end = v_n; }\
+					else{ v_x = v_h[0]; v_h[0] = v_h[v_t]; v_h[v_t] = v_x; }\
+					v_x = v_h[v_root];\
+					while((v_child = 2*v_root+1) < v_end){\
+						if(v_child+1 < v_end && vector_cond_ab((c),v_h[v_child+1],v_h[v_child])) v_child++;\
+						if(!vector_cond_ab((c),v_h[v_child],v_x)) break;\
+						v_h[v_root] = v_h[v_child];\
+						v_root = v_child;\
+					}\
+					v_h[v_root] = v_x;\
+				}\
+				v_lo = v_hi;\
+				break;\
+			}\
+			v_depth--;\
+			/* Median of three, which also puts sentinels at both ends */\
+			size_t v_mid = v_lo+(v_hi-v_lo)/2, v_i = v_lo-1, v_j = v_hi;\
+			if(vector_cond_ab((c),v_arr[v_lo],v_arr[v_mid])){ v_x = v_arr[v_lo]; v_arr[v_lo] = v_arr[v_mid]; v_arr[v_mid] = v_x; }\
+			if(vector_cond_ab((c),v_arr[v_mid],v_arr[v_hi-1])){ v_x = v_arr[v_mid]; v_arr[v_mid] = v_arr[v_hi-1]; v_arr[v_hi-1] = v_x; }\
+			if(vector_cond_ab((c),v_arr[v_lo],v_arr[v_mid])){ v_x = v_arr[v_lo]; v_arr[v_lo] = v_arr[v_mid]; v_arr[v_mid] = v_x; }\
+			typeof(*(v).arr) v_pivot = v_arr[v_mid];\
+			/* Hoare partition: [v_lo, v_j] <= pivot <= [v_j+1, v_hi) */\
+			while(1){\
+				do v_i++; while(vector_cond_ab((c),v_pivot,v_arr[v_i]));\
+				do v_j--; while(vector_cond_ab((c),v_arr[v_j],v_pivot));\
+				if(v_i >= v_j) break;\
+				v_x = v_arr[v_i]; v_arr[v_i] = v_arr[v_j]; v_arr[v_j] = v_x;\
+			}\
+			/* Keep sorting the smallest partition, push the other one */\
+			if(v_j+1-v_lo < v_hi-v_j-1){\
+				v_stack[v_top][0] = v_j+1; v_stack[v_top][1] = v_hi; v_stack[v_top++][2] = v_depth;\
+				v_hi = v_j+1;\
+			}else{\
+				v_stack[v_top][0] = v_lo; v_stack[v_top][1] = v_j+1; v_stack[v_top++][2] = v_depth;\
+				v_lo = v_j+1;\
+			}\
+		}\
+		/* Insertion sort for the small partitions */\
+		for(size_t v_i = v_lo+1; v_i < v_hi; v_i++){\
+			size_t v_j = v_i;\
+			v_x = v_arr[v_i];\
+			while(v_j > v_lo && vector_cond_ab((c),v_arr[v_j-1],v_x)){\
+				v_arr[v_j] = v_arr[v_j-1];\
+				v_j--;\
+			}\
+			v_arr[v_j] = v_x;\
+		}\
+		if(v_top == 0) break;\
+		v_top--;\
+		v_lo = v_stack[v_top][0]; v_hi = v_stack[v_top][1]; v_depth = v_stack[v_top][2];\
+	}\
+})
+
+/*
+Sort the vector using condition c with elements v_a and v_b, like sort_vector
+But equal elements (when the condition is false both ways) keep their order
+Bottom-up merge sort, O(n log n), allocates a buffer of the size of the vector
+Example of usage:
+
+sort_vector(people,v_a.age > v_b.age);
+stable_sort_vector(people,v_a.height > v_b.height); // Same heights are still sorted by age
+*/
+#define stable_sort_vector(v, c) ({\
+	typeof(*(v).arr) v_a, v_b, v_x;\
+	typeof((v).arr) v_arr = (v).arr;\
+	size_t v_n = (v).size;\
+	/* Insertion sort runs of 16 elements */\
+	for(size_t v_lo = 0; v_lo < v_n; v_lo += 16){\
+		size_t v_hi = v_lo+16 < v_n ? v_lo+16 : v_n;\
+		for(size_t v_i = v_lo+1; v_i < v_hi; v_i++){\
+			size_t v_j = v_i;\
+			v_x = v_arr[v_i];\
+			while(v_j > v_lo && vector_cond_ab((c),v_arr[v_j-1],v_x)){\
+				v_arr[v_j] = v_arr[v_j-1];\
+				v_j--;\
+			}\
+			v_arr[v_j] = v_x;\
+		}\
+	}\
+	if(v_n > 16){\
+		/* Merge the runs back and forth between the vector and the buffer */\
+		typeof((v).arr) v_buf = VECTOR_REALLOC(NULL,sizeof(*(v).arr)*v_n);\
+		typeof((v).arr) v_src = v_arr, v_dst = v_buf, v_swap;\
+		for(size_t v_w = 16; v_w < v_n; v_w *= 2){\
+			for(size_t v_lo = 0; v_lo < v_n; v_lo += 2*v_w){\
+				size_t v_mid = v_lo+v_w < v_n ? v_lo+v_w : v_n;\
+				size_t v_hi = v_mid+v_w < v_n ? v_mid+v_w : v_n;\
+				size_t v_i = v_lo, v_j = v_mid, v_k = v_lo;\
+				while(v_i < v_mid && v_j < v_hi){\
+					if(vector_cond_ab((c),v_src[v_i],v_src[v_j])) v_dst[v_k++] = v_src[v_j++];\
+					else v_dst[v_k++] = v_src[v_i++];\
+				}\
+				while(v_i < v_mid) v_dst[v_k++] = v_src[v_i++];\
+				while(v_j < v_hi) v_dst[v_k++] = v_src[v_j++];\
+			}\
+			v_swap = v_src; v_src = v_dst; v_dst = v_swap;\
+		}\
+		if(v_src != v_arr) memcpy(v_arr,v_src,sizeof(*(v).arr)*v_n);\
+		VECTOR_FREE(v_buf);\
+	}\
+})
+
+/*
+The old sorting macro of this header, kept for comparison (see examples/vector_sort_benchmark.c)
+Sort the vector using condition c with elements v_a and v_b
+If condition is true, switch out two elements
+Else, just skip it
+Parse through the vector until everything is at the right place
+Very unefficient, worst case scenario O(n^2), but stable
+*/
+#define bubble_sort_vector(v, c) ({\
 	if((v).size){\
 		typeof(*(v).arr) v_a, v_b;\
 		_Bool v_sorted=0;\
@@ -143,6 +377,138 @@ sort_vector(v,v_a > v_b); // Sorts the array ascendingly
 	}\
 })
 
+// Binary searches
+// These macros only work on a vector sorted with the same condition c (see sort_vector)
+// The condition uses v_a and v_b, and is true when v_a has to be after v_b
+// e is the element to look for (not a pointer!), r is set to an index of the vector
+// They use no branches to pick the next half, so the CPU never mispredicts them
+
+/*
+Set r to the index of the first element that does not have to be before e
+(the first element >= e for an ascending vector), or to the size of the vector if there is none
+Example of usage:
+
+size_t i;
+lower_bound_vector(v,42,v_a > v_b,i); // v is sorted ascendingly
+printf("%lu numbers are smaller than 42\n",i);
+*/
+#define lower_bound_vector(v, e, c, r) ({\
+	typeof(*(v).arr) v_a, v_b, v_target = (e);\
+	typeof((v).arr) v_base = (v).arr;\
+	size_t v_n = (v).size, v_half;\
+	while(v_n > 1){\
+		v_half = v_n/2;\
+		v_base = vector_cond_ab((c),v_target,v_base[v_half-1]) ? v_base+v_half : v_base;\
+		v_n -= v_half;\
+	}\
+	(r) = (v_base-(v).arr) + ((v).size && vector_cond_ab((c),v_target,*v_base));\
+})
+
+// Set r to the index of the first element that has to be after e
+// (the first element > e for an ascending vector), or to the size of the vector if there is none
+#define upper_bound_vector(v, e, c, r) ({\
+	typeof(*(v).arr) v_a, v_b, v_target = (e);\
+	typeof((v).arr) v_base = (v).arr;\
+	size_t v_n = (v).size, v_half;\
+	while(v_n > 1){\
+		v_half = v_n/2;\
+		v_base = vector_cond_ab((c),v_base[v_half-1],v_target) ? v_base : v_base+v_half;\
+		v_n -= v_half;\
+	}\
+	(r) = (v_base-(v).arr) + ((v).size && !vector_cond_ab((c),*v_base,v_target));\
+})
+
+// Set r to the index of an element equal to e (the condition is false both ways)
+// Else, will be set to -1 or ~0, like find_vector
+#define bsearch_vector(v, e, c, r) ({\
+	typeof(*(v).arr) v_a, v_b, v_found = (e);\
+	size_t v_index;\
+	lower_bound_vector((v),v_found,(c),v_index);\
+	(r) = (v_index < (v).size && !vector_cond_ab((c),(v).arr[v_index],v_found)) ? v_index : ~0;\
+})
+
+// Insert element e in sorted vector v, keeping it sorted
+// Goes after the elements equal to it
+#define insert_sorted_vector(v, e, c) ({\
+	typeof(*(v).arr) v_new = (e);\
+	size_t v_index;\
+	upper_bound_vector((v),v_new,(c),v_index);\
+	(v).arr = VECTOR_REALLOC((v).arr,sizeof(*(v).arr)*++(v).size);\
+	memmove((v).arr+v_index+1,(v).arr+v_index,sizeof(*(v).arr)*((v).size-v_index-1));\
+	(v).arr[v_index] = v_new;\
+})
+
+// Insert element e in sorted capacity vector v, keeping it sorted
+#define insert_sorted_vector_cap(v, e, c) ({\
+	typeof(*(v).arr) v_new = (e);\
+	size_t v_index;\
+	upper_bound_vector((v),v_new,(c),v_index);\
+	grow_vector_sized((v),(v).size+1,sizeof(*(v).arr));\
+	memmove((v).arr+v_index+1,(v).arr+v_index,sizeof(*(v).arr)*((v).size++-v_index));\
+	(v).arr[v_index] = v_new;\
+})
+
+// Eytzinger layout
+// For sorted lookup tables that are searched a lot more than they are changed
+// The elements are stored like a binary tree in breadth-first order, starting at index 1:
+// the children of index k are at 2k and 2k+1. The first levels of the search are
+// then packed together in the same cache lines, and the next ones can be prefetched
+
+/*
+Copy sorted vector v to vector d in Eytzinger layout
+d must be another vector of the same type (not a capacity vector), its old content is lost
+d.size is v.size+1, because index 0 is not used
+Example of usage:
+
+sort_vector(v,v_a > v_b);
+struct int_vector table = (struct int_vector) create_vector();
+eytzinger_vector(table,v);
+eytzinger_bsearch_vector(table,42,v_a > v_b,i);
+if(i != -1) printf("found %d\n",at(table,i));
+*/
+#define eytzinger_vector(d, v) ({\
+	size_t v_n = (v).size, v_k = 1;\
+	(d).arr = VECTOR_REALLOC((d).arr,sizeof(*(d).arr)*(v_n+1));\
+	(d).size = v_n ? v_n+1 : 0;\
+	if(v_n) (d).arr[0] = (v).arr[0];\
+	/* In-order walk of the implicit tree, starting at its leftmost node */\
+	while(2*v_k <= v_n) v_k *= 2;\
+	for(size_t v_i = 0; v_i < v_n; v_i++){\
+		(d).arr[v_k] = (v).arr[v_i];\
+		if(2*v_k+1 <= v_n){\
+			v_k = 2*v_k+1;\
+			while(2*v_k <= v_n) v_k *= 2;\
+		}else{\
+			while(v_k & 1) v_k >>= 1;\
+			v_k >>= 1;\
+		}\
+	}\
+})
+
+// Like lower_bound_vector, on a vector in Eytzinger layout
+// Sets r to the index (in v) of the first element that does not have to be before e, or to ~0 if there is none
+#define eytzinger_lower_bound_vector(v, e, c, r) ({\
+	typeof(*(v).arr) v_a, v_b, v_target = (e);\
+	typeof((v).arr) v_arr = (v).arr;\
+	size_t v_k = 1;\
+	while(v_k < (v).size){\
+		__builtin_prefetch(v_arr+16*v_k);\
+		v_k = 2*v_k + vector_cond_ab((c),v_target,v_arr[v_k]);\
+	}\
+	/* Go back up the right turns we took after the element we want */\
+	v_k >>= __builtin_ffsll(~(long long)v_k);\
+	(r) = v_k ? v_k : ~0;\
+})
+
+// Like bsearch_vector, on a vector in Eytzinger layout
+// Sets r to the index (in v) of an element equal to e, or to ~0
+#define eytzinger_bsearch_vector(v, e, c, r) ({\
+	typeof(*(v).arr) v_a, v_b, v_found = (e);\
+	size_t v_index;\
+	eytzinger_lower_bound_vector((v),v_found,(c),v_index);\
+	(r) = (v_index != (size_t)~0 && !vector_cond_ab((c),(v).arr[v_index],v_found)) ? v_index : ~0;\
+})
+
 /*
 Parse through vector, executing statements c
 You can refer to current element of vector with v_element
@@ -195,6 +561,61 @@ struct bool_vector{
 	_Bool* arr;
 	size_t size;
 };
+
+#include <stdint.h>
+
+// LSD radix sort of 32 bit unsigned keys, 8 bits at a time, O(n)
+// tmp needs room for n keys, passes where all keys share the same byte are skipped
+void radix_sort_u32(uint32_t* keys, uint32_t* tmp, size_t n){
+	if(n < 2) return;
+	size_t count[4][256] = {0};
+	uint32_t *src = keys, *dst = tmp, *swap;
+	for(size_t i = 0; i < n; i++){
+		for(int b = 0; b < 4; b++) count[b][(keys[i] >> (8*b)) & 0xFF]++;
+	}
+	for(int b = 0; b < 4; b++){
+		size_t* c = count[b];
+		if(c[(src[0] >> (8*b)) & 0xFF] == n) continue;
+		for(size_t d = 0, offset = 0, tmp_count; d < 256; d++){
+			tmp_count = c[d];
+			c[d] = offset;
+			offset += tmp_count;
+		}
+		for(size_t i = 0; i < n; i++) dst[c[(src[i] >> (8*b)) & 0xFF]++] = src[i];
+		swap = src; src = dst; dst = swap;
+	}
+	if(src != keys) memcpy(keys,src,sizeof(uint32_t)*n);
+}
+
+// Sort an int vector ascendingly with a radix sort
+// Same result as sort_vector(v,v_a > v_b), but much faster on big vectors
+void radix_sort_int_vector(struct int_vector* v){
+	_Static_assert(sizeof(int) == sizeof(uint32_t), "radix_sort_int_vector needs 32 bit ints");
+	if(v->size < 2) return;
+	uint32_t* keys = (uint32_t*) v->arr;
+	uint32_t* tmp = VECTOR_REALLOC(NULL,sizeof(uint32_t)*v->size);
+	// Flipping the sign bit makes negative numbers come first
+	for(size_t i = 0; i < v->size; i++) keys[i] ^= 0x80000000u;
+	radix_sort_u32(keys,tmp,v->size);
+	for(size_t i = 0; i < v->size; i++) keys[i] ^= 0x80000000u;
+	VECTOR_FREE(tmp);
+}
+
+// Sort a float vector ascendingly with a radix sort
+// Same result as sort_vector(v,v_a > v_b) (NaNs end up at the ends), but much faster on big vectors
+void radix_sort_float_vector(struct float_vector* v){
+	_Static_assert(sizeof(float) == sizeof(uint32_t), "radix_sort_float_vector needs 32 bit floats");
+	if(v->size < 2) return;
+	uint32_t* keys = VECTOR_REALLOC(NULL,sizeof(uint32_t)*v->size*2);
+	memcpy(keys,v->arr,sizeof(float)*v->size);
+	// Positive floats get their sign bit set, negative ones get all bits flipped
+	// so that the bits compare like the floats do
+	for(size_t i = 0; i < v->size; i++) keys[i] = (keys[i] & 0x80000000u) ? ~keys[i] : keys[i] | 0x80000000u;
+	radix_sort_u32(keys,keys+v->size,v->size);
+	for(size_t i = 0; i < v->size; i++) keys[i] = (keys[i] & 0x80000000u) ? keys[i] & 0x7FFFFFFFu : ~keys[i];
+	memcpy(v->arr,keys,sizeof(float)*v->size);
+	VECTOR_FREE(keys);
+}
 #endif
 
 #endif